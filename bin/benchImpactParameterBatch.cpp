@@ -0,0 +1,126 @@
+/*
+  benchImpactParameterBatch
+  =========================
+  Compares the batch impact parameter kernel (ImpactParameterBatch.h)
+  with the one track at a time computation of the skimmer, where the
+  vertex and momentum are read from each track object and dxy is
+  computed twice (origin and beam spot).
+
+  usage: benchImpactParameterBatch [number of tracks] [repetitions]
+
+  The tracks are taken in groups of 20, as in GenPurposeSkimmerT, and
+  also all at once, to see the kernel without the gather step.
+
+  Changes Log:
+  ------------
+  19.10.26: first version
+*/
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "ElectroWeakAnalysis/WENu/interface/ImpactParameterBatch.h"
+
+namespace {
+  // stand-in for reco::Track: the kinematics in one object, plus the
+  // rest of the track that the cache has to carry along
+  struct TrackLike {
+    double vx_, vy_, vz_, px_, py_, pz_;
+    double covariance_[15];
+    double vx() const { return vx_; }
+    double vy() const { return vy_; }
+    double px() const { return px_; }
+    double py() const { return py_; }
+    double pt() const { return std::sqrt(px_*px_ + py_*py_); }
+    double dxy() const { return (-vx_*py_ + vy_*px_)/pt(); }
+    double dxy(double x, double y) const {
+      return (-(vx_-x)*py_ + (vy_-y)*px_)/pt();
+    }
+  };
+
+  double seconds(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now()
+					 - start).count();
+  }
+}
+
+int main(int argc, char **argv)
+{
+  const int nTracks = argc > 1 ? std::atoi(argv[1]) : 100000;
+  const int nRep = argc > 2 ? std::atoi(argv[2]) : 100;
+  const double bx = 0.0322, by = -0.0013;
+  //
+  std::mt19937 gen(12345);
+  std::normal_distribution<double> vtx(0., 0.01), mom(0., 5.);
+  std::vector<TrackLike> tracks(nTracks);
+  for (int i=0; i<nTracks; ++i) {
+    TrackLike& t = tracks[i];
+    t.vx_ = vtx(gen);  t.vy_ = vtx(gen);  t.vz_ = 50.*vtx(gen);
+    t.px_ = mom(gen);  t.py_ = mom(gen);  t.pz_ = mom(gen);
+    for (int j=0; j<15; ++j) t.covariance_[j] = 0.;
+  }
+  std::vector<double> tip(nTracks), tipBs(nTracks);
+  std::vector<double> refTip(nTracks), refTipBs(nTracks);
+  //
+  // 1. one track at a time
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+  for (int r=0; r<nRep; ++r) {
+    for (int i=0; i<nTracks; ++i) {
+      refTip[i] = -tracks[i].dxy();
+      refTipBs[i] = -tracks[i].dxy(bx, by);
+    }
+  }
+  const double tScalar = seconds(start);
+  //
+  // 2. batches of 20 tracks, gathered from the objects as in the skimmer
+  start = std::chrono::steady_clock::now();
+  for (int r=0; r<nRep; ++r) {
+    ImpactParameterBatch<20> batch;
+    for (int first=0; first<nTracks; first+=20) {
+      batch.clear();
+      for (int i=first; i<nTracks && not batch.full(); ++i)
+	batch.push_back(tracks[i].vx(), tracks[i].vy(),
+			tracks[i].px(), tracks[i].py());
+      batch.compute(bx, by);
+      for (int i=0; i<batch.size(); ++i) {
+	tip[first+i] = -batch.dxy(i);
+	tipBs[first+i] = -batch.dxyBeamSpot(i);
+      }
+    }
+  }
+  const double tBatch20 = seconds(start);
+  //
+  // 3. the kernel alone on arrays that are already in SoA form
+  std::vector<double> vx(nTracks), vy(nTracks), px(nTracks), py(nTracks);
+  for (int i=0; i<nTracks; ++i) {
+    vx[i] = tracks[i].vx();  vy[i] = tracks[i].vy();
+    px[i] = tracks[i].px();  py[i] = tracks[i].py();
+  }
+  std::vector<double> dxy(nTracks), dxyBs(nTracks);
+  start = std::chrono::steady_clock::now();
+  for (int r=0; r<nRep; ++r) {
+    impactParameterBatch(nTracks, &vx[0], &vy[0], &px[0], &py[0], bx, by,
+			 &dxy[0], &dxyBs[0]);
+  }
+  const double tKernel = seconds(start);
+  //
+  // the results have to agree up to rounding
+  double maxDiff = 0.;
+  for (int i=0; i<nTracks; ++i) {
+    maxDiff = std::max(maxDiff, std::fabs(tip[i] - refTip[i]));
+    maxDiff = std::max(maxDiff, std::fabs(tipBs[i] - refTipBs[i]));
+    maxDiff = std::max(maxDiff, std::fabs(-dxy[i] - refTip[i]));
+    maxDiff = std::max(maxDiff, std::fabs(-dxyBs[i] - refTipBs[i]));
+  }
+  //
+  const double n = double(nTracks)*nRep;
+  std::cout << "tracks: " << nTracks << " x " << nRep << " repetitions" << std::endl;
+  std::cout << "one at a time : " << 1.e9*tScalar/n  << " ns/track" << std::endl;
+  std::cout << "batches of 20 : " << 1.e9*tBatch20/n << " ns/track" << std::endl;
+  std::cout << "kernel only   : " << 1.e9*tKernel/n  << " ns/track" << std::endl;
+  std::cout << "max |difference| : " << maxDiff << " cm" << std::endl;
+  return maxDiff < 1.e-12 ? 0 : 1;
+}
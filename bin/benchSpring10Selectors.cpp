@@ -0,0 +1,110 @@
+/*
+  benchSpring10Selectors
+  ======================
+  Cross-check of the compile time selectors (WenuFixedSelector on the
+  tables of Spring10WorkingPoints.h) with the runtime WenuSelector on the
+  same cuts, for all the working points, and their timing. The exit code
+  is 1 if any decision differs, so that it can be run after the tables
+  are generated again.
+
+  usage: benchSpring10Selectors [number of electrons] [repetitions]
+
+  The electrons are random up to 1.5 times the cut of each enabled
+  variable (about 2/3 pass each cut) and below the "no cut" sentinel for
+  the others.
+
+  Changes Log:
+  ------------
+  19.10.26: first version
+*/
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "ElectroWeakAnalysis/WENu/interface/Spring10WorkingPoints.h"
+
+namespace {
+  const int NVARS = WenuSelectorVars::NVARS;
+
+  double seconds(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now()
+					 - start).count();
+  }
+
+  // compares and times one working point; the number of different decisions
+  template <class WP>
+  int check(int nEle, int nRep, std::mt19937& gen)
+  {
+    const std::vector<double> cuts = WP::cuts();
+    std::uniform_real_distribution<double> unit(0., 1.), eta(-2.5, 2.5);
+    std::vector<WenuPlainElectron> electrons(nEle);
+    for (int k=0; k<nEle; ++k) {
+      WenuPlainElectron& e = electrons[k];
+      e.barrel = std::fabs(eta(gen)) < 1.479;
+      for (int i=0; i<NVARS; ++i) {
+	const double cut = cuts[e.barrel ? i : i+NVARS];
+	const double range = cut < WenuFixedSelectorDisabled ? 1.5*cut : 100.;
+	e.v[i] = (unit(gen) < 0.5 ? -1. : 1.)*range*unit(gen);
+      }
+    }
+    PlainElectronAccessor accessor;
+    WenuSelector<PlainElectronAccessor> runtime(cuts, std::vector<bool>(2*NVARS, false));
+    std::vector<char> runtimePass(nEle), fixedPass(nEle);
+    //
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (int rep=0; rep<nRep; ++rep)
+      for (int k=0; k<nEle; ++k) runtimePass[k] = runtime.passesAll(electrons[k]);
+    const double tRuntime = seconds(start);
+    start = std::chrono::steady_clock::now();
+    for (int rep=0; rep<nRep; ++rep)
+      for (int k=0; k<nEle; ++k)
+	fixedPass[k] = WenuFixedSelector<WP>::passes(accessor, electrons[k]);
+    const double tFixed = seconds(start);
+    //
+    int diff = 0, selected = 0;
+    for (int k=0; k<nEle; ++k) {
+      if (runtimePass[k] != fixedPass[k]) ++diff;
+      selected += fixedPass[k];
+    }
+    const double n = double(nEle)*nRep;
+    std::cout << "  " << WP::name() << ": " << WenuFixedSelector<WP>::enabledCuts()
+	      << " cuts, " << selected << " selected, runtime " << 1.e9*tRuntime/n
+	      << " ns, fixed " << 1.e9*tFixed/n << " ns, different: " << diff << std::endl;
+    return diff;
+  }
+}
+
+int main(int argc, char **argv)
+{
+  const int nEle = argc > 1 ? std::atoi(argv[1]) : 100000;
+  const int nRep = argc > 2 ? std::atoi(argv[2]) : 20;
+  std::mt19937 gen(12345);
+  std::cout << "electrons: " << nEle << " x " << nRep << " repetitions, ns/electron"
+	    << std::endl;
+  int diff = 0;
+  diff += check<Spring10WP95relIso>(nEle, nRep, gen);
+  diff += check<Spring10WP95cIso>(nEle, nRep, gen);
+  diff += check<Spring10WP90relIso>(nEle, nRep, gen);
+  diff += check<Spring10WP90cIso>(nEle, nRep, gen);
+  diff += check<Spring10WP85relIso>(nEle, nRep, gen);
+  diff += check<Spring10WP85cIso>(nEle, nRep, gen);
+  diff += check<Spring10WP80relIso>(nEle, nRep, gen);
+  diff += check<Spring10WP80cIso>(nEle, nRep, gen);
+  diff += check<Spring10WP70relIso>(nEle, nRep, gen);
+  diff += check<Spring10WP70cIso>(nEle, nRep, gen);
+  diff += check<Spring10WP60relIso>(nEle, nRep, gen);
+  diff += check<Spring10WP60cIso>(nEle, nRep, gen);
+  //
+  // the lookup by name finds every block
+  const std::vector<std::string> names = spring10WorkingPoints();
+  for (unsigned int w=0; w<names.size(); ++w)
+    if (spring10Selection<PlainElectronAccessor>(names[w]) == 0) {
+      std::cout << "no selector for " << names[w] << std::endl;
+      ++diff;
+    }
+  return diff == 0 ? 0 : 1;
+}
@@ -0,0 +1,153 @@
+/*
+  benchWenuKinematics
+  ===================
+  Compares the batch ET/MT kernels (WenuKinematics.h) with the scalar
+  expressions that WenuPlots had: the electron ET with cosh, then calo,
+  pf and tc MT, each with its own cos/sin of the electron and MET phi,
+  and the MT of the histograms once more.
+
+  usage: benchWenuKinematics [number of events] [repetitions]
+
+  Three ways: the scalar code per event, a WenuKinematics<2,3> per event
+  as in WenuPlots, and the kernels alone on all the events at once
+  (structure of arrays, as for a tuple; the MET x, y of the tuple are
+  not in the timing).
+
+  Changes Log:
+  ------------
+  19.10.26: first version
+*/
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "ElectroWeakAnalysis/WENu/interface/WenuKinematics.h"
+
+namespace {
+  // what WenuPlots reads for one event
+  struct EventLike {
+    double scEnergy, scEta, scPhi, gsfEta;
+    double met[3], metPhi[3];
+  };
+
+  double seconds(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now()
+					 - start).count();
+  }
+}
+
+int main(int argc, char **argv)
+{
+  const int nEvents = argc > 1 ? std::atoi(argv[1]) : 100000;
+  const int nRep = argc > 2 ? std::atoi(argv[2]) : 100;
+  //
+  std::mt19937 gen(12345);
+  std::uniform_real_distribution<double> phi(-M_PI, M_PI), eta(-2.5, 2.5);
+  std::normal_distribution<double> energy(80., 30.), met(35., 10.), dEta(0., 0.01);
+  std::vector<EventLike> events(nEvents);
+  for (int i=0; i<nEvents; ++i) {
+    EventLike& ev = events[i];
+    ev.scEnergy = std::fabs(energy(gen));
+    ev.scEta = eta(gen);
+    ev.gsfEta = ev.scEta + dEta(gen);
+    ev.scPhi = phi(gen);
+    for (int m=0; m<3; ++m) {
+      ev.met[m] = std::fabs(met(gen));
+      ev.metPhi[m] = phi(gen);
+    }
+  }
+  // 4 MT per event: calo, pf, tc for the tuple, calo for the histograms
+  std::vector<double> refMt(4*nEvents), mt(4*nEvents), kernelMt(4*nEvents);
+  //
+  // 1. the scalar expressions
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+  for (int r=0; r<nRep; ++r) {
+    for (int i=0; i<nEvents; ++i) {
+      const EventLike& ev = events[i];
+      const double et = ev.scEnergy/std::cosh(ev.gsfEta);
+      for (int m=0; m<3; ++m)
+	refMt[4*i+m] = std::sqrt(2.*(et*ev.met[m] -
+	  (et*std::cos(ev.scPhi)*ev.met[m]*std::cos(ev.metPhi[m])
+	   + et*std::sin(ev.scPhi)*ev.met[m]*std::sin(ev.metPhi[m]))));
+      const double scEt = ev.scEnergy/std::cosh(ev.scEta);
+      refMt[4*i+3] = std::sqrt(2.0*scEt*ev.met[0]*(1.0-(std::cos(ev.scPhi)*std::cos(ev.metPhi[0])
+							+std::sin(ev.scPhi)*std::sin(ev.metPhi[0]))));
+    }
+  }
+  const double tScalar = seconds(start);
+  //
+  // 2. one WenuKinematics per event, as in WenuPlots
+  start = std::chrono::steady_clock::now();
+  for (int r=0; r<nRep; ++r) {
+    for (int i=0; i<nEvents; ++i) {
+      const EventLike& ev = events[i];
+      WenuKinematics<2, 3> kin;
+      const int eTuple = kin.addElectron(transverseEnergy(ev.scEnergy, ev.gsfEta), ev.scPhi);
+      const int eHisto = kin.addElectronAlong(eTuple, transverseEnergy(ev.scEnergy, ev.scEta));
+      for (int m=0; m<3; ++m) kin.addMet(ev.met[m], ev.metPhi[m]);
+      kin.compute();
+      for (int m=0; m<3; ++m) mt[4*i+m] = kin.mt(eTuple, m);
+      mt[4*i+3] = kin.mt(eHisto, 0);
+    }
+  }
+  const double tEvent = seconds(start);
+  //
+  // 3. the kernels alone, all the events at once (transverseMassPairs),
+  // with the x, y components filled once as in a SoA tuple
+  std::vector<double> e(nEvents), gsfEta(nEvents), scEta(nEvents);
+  std::vector<double> etTuple(nEvents), etHisto(nEvents);
+  std::vector<double> ex(nEvents), ey(nEvents), hx(nEvents), hy(nEvents);
+  std::vector<double> mets[3], mx[3], my[3], out[4];
+  for (int i=0; i<nEvents; ++i) {
+    e[i] = events[i].scEnergy;
+    gsfEta[i] = events[i].gsfEta;  scEta[i] = events[i].scEta;
+  }
+  for (int m=0; m<3; ++m) {
+    mets[m].resize(nEvents);  mx[m].resize(nEvents);  my[m].resize(nEvents);
+    for (int i=0; i<nEvents; ++i) {
+      mets[m][i] = events[i].met[m];
+      mx[m][i] = events[i].met[m]*std::cos(events[i].metPhi[m]);
+      my[m][i] = events[i].met[m]*std::sin(events[i].metPhi[m]);
+    }
+  }
+  for (int m=0; m<4; ++m) out[m].resize(nEvents);
+  start = std::chrono::steady_clock::now();
+  for (int r=0; r<nRep; ++r) {
+    transverseEnergyBatch(nEvents, &e[0], &gsfEta[0], &etTuple[0]);
+    transverseEnergyBatch(nEvents, &e[0], &scEta[0], &etHisto[0]);
+    for (int i=0; i<nEvents; ++i) {
+      const double c = std::cos(events[i].scPhi), s = std::sin(events[i].scPhi);
+      ex[i] = etTuple[i]*c;  ey[i] = etTuple[i]*s;
+      hx[i] = etHisto[i]*c;  hy[i] = etHisto[i]*s;
+    }
+    for (int m=0; m<3; ++m)
+      transverseMassPairs(nEvents, &etTuple[0], &ex[0], &ey[0],
+			  &mets[m][0], &mx[m][0], &my[m][0], &out[m][0]);
+    transverseMassPairs(nEvents, &etHisto[0], &hx[0], &hy[0],
+			&mets[0][0], &mx[0][0], &my[0][0], &out[3][0]);
+  }
+  const double tKernel = seconds(start);
+  for (int i=0; i<nEvents; ++i)
+    for (int m=0; m<4; ++m) kernelMt[4*i+m] = out[m][i];
+  //
+  // the results have to agree up to rounding, which is largest for a
+  // small MT: sqrt(ET*MET*epsilon)
+  double maxDiff = 0.;
+  for (int i=0; i<4*nEvents; ++i) {
+    if (std::isnan(refMt[i])) continue;   // MT^2 < 0 in the scalar code
+    maxDiff = std::max(maxDiff, std::fabs(mt[i] - refMt[i]));
+    maxDiff = std::max(maxDiff, std::fabs(kernelMt[i] - refMt[i]));
+  }
+  //
+  const double n = double(nEvents)*nRep;
+  std::cout << "events: " << nEvents << " x " << nRep << " repetitions" << std::endl;
+  std::cout << "scalar code        : " << 1.e9*tScalar/n << " ns/event" << std::endl;
+  std::cout << "WenuKinematics<2,3>: " << 1.e9*tEvent/n  << " ns/event" << std::endl;
+  std::cout << "kernels, all events: " << 1.e9*tKernel/n << " ns/event" << std::endl;
+  std::cout << "max |difference| : " << maxDiff << " GeV" << std::endl;
+  return maxDiff < 1.e-5 ? 0 : 1;
+}
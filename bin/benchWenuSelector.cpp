@@ -0,0 +1,188 @@
+/*
+  benchWenuSelector
+  =================
+  Checks that WenuSelector gives the decisions of the WenuPlots code
+  (CheckCuts, CheckCutsInverse, CheckCutsNminusOne, as they were on
+  CutVars_ and InvVars_) and that the tuple level reselection
+  (VbtfTupleRow, float branches) agrees with the full precision one, and
+  times them.
+
+  usage: benchWenuSelector [number of electrons] [repetitions]
+
+  The electrons are random around the WP80 cuts, so that every cut
+  matters; each one is a WenuPlainElectron (absolute isolations and pt
+  as in the EDM) and the VbtfTupleRow that WenuPlots would write.
+  Decisions of the tuple may differ for a value within float rounding
+  of a cut; these are counted.
+
+  Changes Log:
+  ------------
+  19.10.26: first version
+*/
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "ElectroWeakAnalysis/WENu/interface/WenuSelector.h"
+
+namespace {
+  const int NVARS = WenuSelectorVars::NVARS;
+
+  double seconds(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now()
+					 - start).count();
+  }
+
+  // the WenuPlots code before WenuSelector, on the plain variables
+  struct Reference {
+    std::vector<double> CutVars_;
+    std::vector<bool> InvVars_;
+    bool CheckCut(const WenuPlainElectron& e, int i) const {
+      if (e.barrel) return std::fabs(e.v[i]) < CutVars_[i];
+      return std::fabs(e.v[i]) < CutVars_[i+NVARS];
+    }
+    bool CheckCutInv(const WenuPlainElectron& e, int i) const {
+      if (e.barrel) {
+	if (InvVars_[i])
+	  return std::fabs(e.v[i]) > CutVars_[i];
+	return std::fabs(e.v[i]) < CutVars_[i];
+      }
+      if (InvVars_[i+NVARS]) {
+	if (InvVars_[i])
+	  return std::fabs(e.v[i]) > CutVars_[i+NVARS];
+      }
+      return std::fabs(e.v[i]) < CutVars_[i+NVARS];
+    }
+    bool CheckCuts(const WenuPlainElectron& e) const {
+      for (int i=0; i<NVARS; ++i) if (not CheckCut(e, i)) return false;
+      return true;
+    }
+    bool CheckCutsInverse(const WenuPlainElectron& e) const {
+      for (int i=0; i<NVARS; ++i) if (not CheckCutInv(e, i)) return false;
+      return true;
+    }
+    bool CheckCutsNminusOne(const WenuPlainElectron& e, int jj) const {
+      for (int i=0; i<NVARS; ++i) {
+	if (i == jj) continue;
+	if (not CheckCut(e, i)) return false;
+      }
+      return true;
+    }
+  };
+
+  // the decisions of one electron: all, inverse, N-1 for each variable
+  template <class Selector, class Electron>
+  int decisions(const Selector& s, const Electron& e) {
+    int bits = s.passesAll(e) | (s.passesInverse(e) << 1);
+    for (int i=0; i<NVARS; ++i) bits |= s.passesNminusOne(e, i) << (2+i);
+    return bits;
+  }
+}
+
+int main(int argc, char **argv)
+{
+  const int nEle = argc > 1 ? std::atoi(argv[1]) : 100000;
+  const int nRep = argc > 2 ? std::atoi(argv[2]) : 20;
+  //
+  // WP80 relative isolation, EB then EE; cIso, tip, E/p not used
+  const double cutsEB[NVARS] = {0.09, 0.07, 0.10, 0.01, 0.06, 0.004, 0.04,
+				1000., 1000., 1000., 1000., 1000., 1000.};
+  const double cutsEE[NVARS] = {0.04, 0.05, 0.025, 0.03, 0.03, 0.007, 0.025,
+				1000., 1000., 1000., 1000., 1000., 1000.};
+  std::vector<double> cuts(cutsEB, cutsEB+NVARS);
+  cuts.insert(cuts.end(), cutsEE, cutsEE+NVARS);
+  // the ABCD inversion: dphi and deta, EB and EE
+  std::vector<bool> inverted(2*NVARS, false);
+  inverted[WenuSelectorVars::DPHI] = inverted[WenuSelectorVars::DPHI+NVARS] = true;
+  inverted[WenuSelectorVars::DETA] = inverted[WenuSelectorVars::DETA+NVARS] = true;
+  Reference reference;
+  reference.CutVars_ = cuts;
+  reference.InvVars_ = inverted;
+  //
+  std::mt19937 gen(12345);
+  std::uniform_real_distribution<double> eta(-2.5, 2.5), unit(0., 1.);
+  std::normal_distribution<double> et(40., 15.);
+  std::vector<WenuPlainElectron> plain(nEle);
+  std::vector<VbtfTupleRow> rows(nEle);
+  for (int k=0; k<nEle; ++k) {
+    WenuPlainElectron& e = plain[k];
+    const double scEta = eta(gen);
+    const double pt = std::max(5., std::fabs(et(gen)));
+    e.barrel = std::fabs(scEta) < 1.479;
+    const double *c = e.barrel ? cutsEB : cutsEE;
+    // up to twice the cut: about half of the electrons pass each one
+    const double trk = 2.*c[0]*unit(gen)*pt, ecal = 2.*c[1]*unit(gen)*pt;
+    const double hcal = 2.*c[2]*unit(gen)*pt;
+    e.v[WenuSelectorVars::TRACK_ISO] = trk/pt;
+    e.v[WenuSelectorVars::ECAL_ISO] = ecal/pt;
+    e.v[WenuSelectorVars::HCAL_ISO] = hcal/pt;
+    for (int i=WenuSelectorVars::SIHIH; i<=WenuSelectorVars::HOE; ++i)
+      e.v[i] = (unit(gen) < 0.5 ? -1. : 1.)*1.3*c[i]*unit(gen);
+    e.v[WenuSelectorVars::C_ISO] = e.barrel ? (trk + std::max(0., ecal-1.) + hcal)/pt
+      : (trk + ecal + hcal)/pt;
+    e.v[WenuSelectorVars::TIP_BSPOT] = 0.05*unit(gen);
+    e.v[WenuSelectorVars::EOP] = 0.5 + unit(gen);
+    for (int i=WenuSelectorVars::TRACK_ISO_USER; i<NVARS; ++i) e.v[i] = 0.;
+    //
+    VbtfTupleRow& r = rows[k];
+    r.ele_sc_eta = scEta;         r.ele_cand_et = pt;
+    r.ele_iso_track = trk/pt;     r.ele_iso_ecal = ecal/pt;   r.ele_iso_hcal = hcal/pt;
+    r.ele_id_sihih = e.v[WenuSelectorVars::SIHIH];
+    r.ele_id_dphi = e.v[WenuSelectorVars::DPHI];
+    r.ele_id_deta = e.v[WenuSelectorVars::DETA];
+    r.ele_id_hoe = e.v[WenuSelectorVars::HOE];
+    r.ele_tip_bs = -e.v[WenuSelectorVars::TIP_BSPOT];
+    r.ele_eop = e.v[WenuSelectorVars::EOP];
+  }
+  //
+  WenuSelector<PlainElectronAccessor> plainSelector(cuts, inverted);
+  WenuSelector<VbtfTupleRowAccessor> tupleSelector(cuts, inverted);
+  std::vector<int> refBits(nEle), plainBits(nEle), tupleBits(nEle);
+  //
+  // 1. the WenuPlots code
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+  for (int rep=0; rep<nRep; ++rep) {
+    for (int k=0; k<nEle; ++k) {
+      const WenuPlainElectron& e = plain[k];
+      int bits = reference.CheckCuts(e) | (reference.CheckCutsInverse(e) << 1);
+      for (int i=0; i<NVARS; ++i) bits |= reference.CheckCutsNminusOne(e, i) << (2+i);
+      refBits[k] = bits;
+    }
+  }
+  const double tReference = seconds(start);
+  //
+  // 2. WenuSelector, plain electrons
+  start = std::chrono::steady_clock::now();
+  for (int rep=0; rep<nRep; ++rep)
+    for (int k=0; k<nEle; ++k) plainBits[k] = decisions(plainSelector, plain[k]);
+  const double tPlain = seconds(start);
+  //
+  // 3. WenuSelector, tuple rows
+  start = std::chrono::steady_clock::now();
+  for (int rep=0; rep<nRep; ++rep)
+    for (int k=0; k<nEle; ++k) tupleBits[k] = decisions(tupleSelector, rows[k]);
+  const double tTuple = seconds(start);
+  //
+  int plainDiff = 0, tupleDiff = 0, selected = 0, inverse = 0;
+  for (int k=0; k<nEle; ++k) {
+    if (plainBits[k] != refBits[k]) ++plainDiff;
+    if (tupleBits[k] != refBits[k]) ++tupleDiff;
+    selected += refBits[k] & 1;
+    inverse += (refBits[k] >> 1) & 1;
+  }
+  //
+  const double n = double(nEle)*nRep;
+  std::cout << "electrons: " << nEle << " x " << nRep << " repetitions, "
+	    << selected << " selected, " << inverse << " inverse" << std::endl;
+  std::cout << "WenuPlots code     : " << 1.e9*tReference/n << " ns/electron" << std::endl;
+  std::cout << "WenuSelector, plain: " << 1.e9*tPlain/n << " ns/electron" << std::endl;
+  std::cout << "WenuSelector, tuple: " << 1.e9*tTuple/n << " ns/electron" << std::endl;
+  std::cout << "different decisions: plain " << plainDiff << ", tuple " << tupleDiff
+	    << std::endl;
+  // the plain selector is the same code; the tuple only differs by rounding
+  return plainDiff == 0 && tupleDiff <= nEle/10000 ? 0 : 1;
+}
@@ -0,0 +1,153 @@
+/*
+  plotCombiner
+  ============
+  The PlotCombiner macro (macros/PlotCombiner.cc) as an executable: no
+  ROOT interpreter, batch drawing, exit status 0 if all went well.
+
+  usage: plotCombiner [options]
+    -i, --input <file>     input list (default: inputFiles), same format
+                           as for the macro
+    -m, --mode <mode>      wenu, zee or the full abcd(...) string; if not
+                           given the 2nd line of the input list is used
+    -t, --threads <n>      threads for the merging and the ABCD scan
+                           (default: 0, one per core)
+    -o, --merged <file>    merged histograms (default: combinedHistos.root)
+    -c, --cache <file>     cache of the input histograms, only new or
+                           changed inputs are read (default:
+                           combinedHistos.cache)
+    --no-cache             read all the inputs, no cache
+    --content-hash         changed inputs: by content, not by size and time
+    -s, --scan <n>         ABCD mc: points per parameter of the systematics
+                           scan (default: 11, 0: no scan)
+    --surface <file>       the scan output (default: abcd_syst_scan.root)
+    --toys <n>             ABCD: toys for the statistical error
+                           (default: 100000, 0: no toys)
+    --seed <n>             seed of the toys (default: 12345)
+    --toyfile <file>       S of the toys (default: abcd_toys.root)
+    ABCD method (any of these selects it):
+    --I=, --dI=, --Fz=, --dFz=, --FzP=, --dFzP=, --ewkerror=, --METCut=
+    --data | --mc | --mcOnly
+    ABCD method from the tuples (abcdTuples(...)):
+    --tuples, the ABCD options above and the inverse selection
+    --<var>_EB=, --<var>_EE=, --<var>_inv  (var = trackIso, ecalIso, hcalIso,
+                           sihih, dphi, deta, hoe)
+    --scanMin=, --scanMax=, --scanStep=  MET cuts of the scan (0, 100, 1)
+    --scanfile <file>      the scan output (default: abcd_met_scan.root)
+    -h, --help
+
+  exit status: 0 ok, 1 configuration error, 2 input histograms not found
+
+  Changes Log:
+  ------------
+  19.10.26: first version
+  19.10.26: -s, --surface for the ABCD systematics scan
+  19.10.26: --toys, --seed, --toyfile for the ABCD toys
+  19.10.26: -c, --no-cache, --content-hash for the input cache
+  19.10.26: --tuples and its options for the ABCD method from the tuples
+*/
+#define PLOTCOMBINER_STANDALONE
+#include "ElectroWeakAnalysis/WENu/macros/PlotCombiner.cc"
+
+#include <cstdlib>
+#include <cstring>
+
+namespace {
+  void usage(const char *prog)
+  {
+    std::cout << "usage: " << prog << " [-i inputFiles] [-m wenu|zee|abcd(...)]"
+	      << " [-t threads] [-o combinedHistos.root]"
+	      << " [-c combinedHistos.cache|--no-cache] [--content-hash]" << std::endl
+	      << "      "
+	      << " [-s points] [--surface abcd_syst_scan.root]" << std::endl
+	      << "       [--toys n] [--seed n] [--toyfile abcd_toys.root]" << std::endl
+	      << "       [--I=.. --dI=.. --Fz=.. --dFz=.. --FzP=.. --dFzP=.."
+	      << " --ewkerror=.. --METCut=.. --data|--mc|--mcOnly]" << std::endl
+	      << "       [--tuples --deta_EB=.. --deta_EE=.. --deta_inv ..."
+	      << " --scanMin=.. --scanMax=.. --scanStep=.. --scanfile abcd_met_scan.root]"
+	      << std::endl;
+  }
+  // the ABCD parameters that can be given on the command line
+  const char *abcdParameters[] = {"I", "dI", "Fz", "dFz", "FzP", "dFzP",
+				  "ewkerror", "METCut", 0};
+  const char *abcdFlags[] = {"data", "mc", "mcOnly", 0};
+  // the inverse selection of abcdTuples
+  bool tupleCut(const TString& arg)
+  {
+    for (int v=0; v<ABCDTupleCuts::NVARS; ++v) {
+      const TString var = TString("--") + ABCDTupleCuts::name(v);
+      if (arg.BeginsWith(var + "_EB=") || arg.BeginsWith(var + "_EE=") ||
+	  arg == var + "_inv") return true;
+    }
+    return false;
+  }
+  double value(const TString& arg)
+  {
+    return TString(arg(arg.Index("=")+1, arg.Length())).Atof();
+  }
+}
+
+int main(int argc, char **argv)
+{
+  TString inputList = "inputFiles";
+  TString mode = "";
+  TString abcdArgs = "";
+  bool tuples = false;
+  for (int i=1; i<argc; ++i) {
+    const TString arg(argv[i]);
+    const bool hasValue = i+1 < argc;
+    if (arg == "-h" || arg == "--help") {
+      usage(argv[0]);
+      return PLOTCOMBINER_OK;
+    }
+    else if ((arg == "-i" || arg == "--input") && hasValue) inputList = argv[++i];
+    else if ((arg == "-m" || arg == "--mode") && hasValue) mode = argv[++i];
+    else if ((arg == "-t" || arg == "--threads") && hasValue)
+      gMergeThreads = std::atoi(argv[++i]);
+    else if ((arg == "-o" || arg == "--merged") && hasValue)
+      gMergedHistos = argv[++i];
+    else if ((arg == "-c" || arg == "--cache") && hasValue)
+      gMergeCache = argv[++i];
+    else if (arg == "--no-cache") gMergeCache = "";
+    else if (arg == "--content-hash") gMergeCacheContent = true;
+    else if ((arg == "-s" || arg == "--scan") && hasValue)
+      gScanPoints = std::atoi(argv[++i]);
+    else if (arg == "--surface" && hasValue) gScanSurface = argv[++i];
+    else if (arg == "--toys" && hasValue) gToys = std::atoi(argv[++i]);
+    else if (arg == "--seed" && hasValue)
+      gToySeed = std::strtoull(argv[++i], 0, 10);
+    else if (arg == "--toyfile" && hasValue) gToyFile = argv[++i];
+    else if (arg == "--tuples") tuples = true;
+    else if (arg.BeginsWith("--scanMin=")) gMetScanMin = value(arg);
+    else if (arg.BeginsWith("--scanMax=")) gMetScanMax = value(arg);
+    else if (arg.BeginsWith("--scanStep=")) gMetScanStep = value(arg);
+    else if (arg == "--scanfile" && hasValue) gMetScanFile = argv[++i];
+    else {
+      // --name=value or --flag of the ABCD method
+      bool known = tupleCut(arg);
+      for (int p=0; abcdParameters[p] && !known; ++p)
+	known = arg.BeginsWith(TString("--") + abcdParameters[p] + "=");
+      for (int p=0; abcdFlags[p] && !known; ++p)
+	known = arg == TString("--") + abcdFlags[p];
+      if (!known) {
+	std::cout << "Unknown option " << arg << std::endl;
+	usage(argv[0]);
+	return PLOTCOMBINER_CONFIG_ERROR;
+      }
+      if (abcdArgs.Length() > 0) abcdArgs += ",";
+      abcdArgs += TString(arg(2, arg.Length()-2));
+    }
+  }
+  // the same string as in the input list: abcd(I=0.95,dI=0.01,...,mc)
+  if (abcdArgs.Length() > 0 || tuples) {
+    const TString abcdMode = tuples ? "abcdTuples" : "abcd";
+    if (mode.Length() > 0 && mode != abcdMode) {
+      std::cout << "ABCD parameters given with mode " << mode << std::endl;
+      return PLOTCOMBINER_CONFIG_ERROR;
+    }
+    mode = abcdMode + "(" + abcdArgs + ")";
+  }
+  //
+  // nothing is displayed: draw in batch mode
+  gROOT->SetBatch(kTRUE);
+  return runPlotCombiner(inputList, mode);
+}
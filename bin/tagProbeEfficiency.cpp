@@ -0,0 +1,168 @@
+/*
+  tagProbeEfficiency
+  ==================
+  Efficiencies from the probe_tree of the GenPurposeSkimmer, in bins of
+  probe ET x eta (x run) with Clopper-Pearson intervals, all the tests in
+  one parallel pass (macros/TagProbeEfficiency.h).
+
+  usage: tagProbeEfficiency [options] file.root ...
+    -t, --threads <n>      threads (default: 0, one per core)
+    -o, --output <file>    efficiency histograms (default:
+                           tagProbeEfficiencies.root)
+    --et=e0,e1,...         ET bin edges (default: 20,30,40,50,100)
+    --eta=e0,e1,...        eta bin edges (default: 0,1.4442,1.566,2.5)
+    --signed-eta           the eta bins are in eta, not |eta|
+    --runs=r0,r1,...       run bins, [r0,r1) ... (default: all runs)
+    --cl=<cl>              confidence level of the intervals (default: 0.683)
+    --flag <name>=<branch>[:<column>]
+                           test: the int branch (column) != 0, e.g.
+                           hlt=probe_trigger_cut:0
+    --cut <name>=<branch><<value>, --cut <name>=<branch>><value>
+                           test: a cut on a double branch, e.g.
+                           iso=probe_isolation_value<0.1
+    --require <branch>[:<column>], --require <branch><<value>, ...
+                           the same, for all the probes of the denominator
+    -h, --help
+
+  exit status: 0 ok, 1 configuration error, 2 input not readable
+
+  Changes Log:
+  ------------
+  19.10.26: first version
+*/
+#include "ElectroWeakAnalysis/WENu/macros/TagProbeEfficiency.h"
+
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+#include "TString.h"
+
+namespace {
+  enum { OK = 0, CONFIG_ERROR = 1, INPUT_ERROR = 2 };
+
+  void usage(const char *prog)
+  {
+    std::cout << "usage: " << prog << " [-t threads] [-o tagProbeEfficiencies.root]"
+	      << " [--et=..] [--eta=..] [--signed-eta] [--runs=..] [--cl=0.683]"
+	      << std::endl
+	      << "       [--flag name=branch[:column]] [--cut name=branch<value]"
+	      << " [--require branch[:column]|branch<value] file.root ..."
+	      << std::endl;
+  }
+  // comma separated bin edges, increasing
+  bool edges(const TString& arg, std::vector<double>& v)
+  {
+    TString list = arg(arg.Index("=")+1, arg.Length());
+    v.clear();
+    Ssiz_t from = 0;
+    TString token;
+    while (list.Tokenize(token, from, ",")) {
+      v.push_back(token.Atof());
+      if (v.size() > 1 && !(v[v.size()-1] > v[v.size()-2])) return false;
+    }
+    return v.size() > 1;
+  }
+  // branch[:column] (kind FLAG) or branch<value, branch>value
+  bool test(const TString& spec, TString& branch, int& kind, int& column,
+	    double& cut)
+  {
+    const Ssiz_t less = spec.Index("<"), greater = spec.Index(">");
+    const Ssiz_t op = less >= 0 ? less : greater;
+    column = 0;  cut = 0.;
+    if (op > 0) {
+      kind = less >= 0 ? TagProbeEfficiency::LESS : TagProbeEfficiency::GREATER;
+      branch = spec(0, op);
+      const TString value = spec(op+1, spec.Length());
+      cut = value.Atof();
+      return value.IsFloat();
+    }
+    kind = TagProbeEfficiency::FLAG;
+    const Ssiz_t colon = spec.Index(":");
+    branch = colon >= 0 ? TString(spec(0, colon)) : spec;
+    if (colon >= 0) {
+      const TString value = spec(colon+1, spec.Length());
+      column = value.Atoi();
+      if (!value.IsDigit()) return false;
+    }
+    return branch.Length() > 0;
+  }
+}
+
+int main(int argc, char **argv)
+{
+  int nThreads = 0;
+  TString output = "tagProbeEfficiencies.root";
+  double cl = 0.683;
+  bool absEta = true;
+  std::vector<double> et, eta, runs;
+  const double defaultEt[5] = {20., 30., 40., 50., 100.};
+  const double defaultEta[4] = {0., 1.4442, 1.566, 2.5};
+  et.assign(defaultEt, defaultEt+5);
+  eta.assign(defaultEta, defaultEta+4);
+  std::vector<TString> files;
+  TagProbeEfficiency eff;
+  for (int i=1; i<argc; ++i) {
+    const TString arg(argv[i]);
+    const bool hasValue = i+1 < argc;
+    if (arg == "-h" || arg == "--help") {
+      usage(argv[0]);
+      return OK;
+    }
+    else if ((arg == "-t" || arg == "--threads") && hasValue)
+      nThreads = std::atoi(argv[++i]);
+    else if ((arg == "-o" || arg == "--output") && hasValue) output = argv[++i];
+    else if (arg == "--signed-eta") absEta = false;
+    else if (arg.BeginsWith("--cl=")) cl = TString(arg(5, arg.Length())).Atof();
+    else if (arg.BeginsWith("--et=") || arg.BeginsWith("--eta=") ||
+	     arg.BeginsWith("--runs=")) {
+      std::vector<double>& v = arg.BeginsWith("--et=") ? et :
+	(arg.BeginsWith("--eta=") ? eta : runs);
+      if (!edges(arg, v)) {
+	std::cout << "Bad bin edges " << arg << std::endl;
+	return CONFIG_ERROR;
+      }
+    }
+    else if ((arg == "--flag" || arg == "--cut" || arg == "--require") && hasValue) {
+      TString spec = argv[++i], name, branch;
+      if (arg != "--require") {
+	const Ssiz_t eq = spec.Index("=");
+	name = eq > 0 ? TString(spec(0, eq)) : TString("");
+	spec = spec(eq+1, spec.Length());
+      }
+      int kind, column;
+      double cut;
+      const bool ok = test(spec, branch, kind, column, cut) &&
+	(arg == "--require" || name.Length() > 0) &&
+	(arg != "--flag" || kind == TagProbeEfficiency::FLAG) &&
+	(arg != "--cut" || kind != TagProbeEfficiency::FLAG);
+      if (!ok) {
+	std::cout << "Bad " << arg << " " << argv[i] << std::endl;
+	usage(argv[0]);
+	return CONFIG_ERROR;
+      }
+      const bool less = kind == TagProbeEfficiency::LESS;
+      if (arg == "--require") {
+	if (kind == TagProbeEfficiency::FLAG) eff.requireFlag(branch, column);
+	else eff.requireCut(branch, less, cut);
+      }
+      else if (kind == TagProbeEfficiency::FLAG) eff.addFlag(name, branch, column);
+      else eff.addCut(name, branch, less, cut);
+    }
+    else if (arg.BeginsWith("-")) {
+      std::cout << "Unknown option " << arg << std::endl;
+      usage(argv[0]);
+      return CONFIG_ERROR;
+    }
+    else files.push_back(arg);
+  }
+  if (files.empty() || eff.nTests() == 0 || !(cl > 0. && cl < 1.)) {
+    std::cout << "Need input files, at least one --flag or --cut and 0 < cl < 1"
+	      << std::endl;
+    usage(argv[0]);
+    return CONFIG_ERROR;
+  }
+  eff.setBins(et, eta, runs, absEta);
+  if (!eff.run(files, nThreads)) return INPUT_ERROR;
+  eff.print(cl);
+  return eff.write(output, cl) ? OK : INPUT_ERROR;
+}
@@ -0,0 +1,158 @@
+#ifndef CutFlowMonitor_H
+#define CutFlowMonitor_H
+/*
+  CutFlowMonitor
+  ==============
+  Cut-flow counters and per stage timers for WenuPlots and the
+  GenPurposeSkimmerT modules: where the events are lost and where the
+  time of the module goes, beyond the total of the framework report.
+
+  Compiled in only with WENU_CUTFLOW defined, e.g.
+      scram b USER_CXXFLAGS="-DWENU_CUTFLOW"
+  Without it CutFlowMonitor is an empty class with empty inline methods,
+  like the "No..." skimmer policies: the calls compile away and the code
+  that is guarded by CutFlowMonitor::enabled is dropped as dead code.
+
+  The stages are given once, in the constructor; counting and timing are
+  relaxed atomic additions, so one monitor can be shared by the streams
+  of a global module.
+
+    CutFlowMonitor monitor(counterNames, timerNames);
+    monitor.count(SELECTED);
+    {
+      CutFlowMonitor::Timer timer(monitor, T_FETCH);
+      ...                          // fetch
+      timer.next(T_SELECTION);     // the fetch stops, the selection starts
+      ...
+    }                              // the selection stops
+
+  At the end of the job print() writes the summary table and write()
+  a tab separated file, one line per stage:
+      counter <name> <count>
+      timer   <name> <calls> <total ns>
+  counters() gives the current counts at any time, e.g. for a snapshot
+  during the job (empty without WENU_CUTFLOW).
+
+  Changes Log:
+  ------------
+  19.10.26: first version
+  19.10.26: counters()
+*/
+#include <string>
+#include <utility>
+#include <vector>
+
+#ifdef WENU_CUTFLOW
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+
+class CutFlowMonitor {
+ public:
+  static const bool enabled = true;
+
+  CutFlowMonitor(const std::vector<std::string>& counters,
+		 const std::vector<std::string>& timers):
+    counterNames_(counters), timerNames_(timers),
+    counts_(counters.size()), calls_(timers.size()), nanoseconds_(timers.size()) {
+    for (unsigned int c=0; c<counts_.size(); ++c) counts_[c] = 0;
+    for (unsigned int t=0; t<calls_.size(); ++t) { calls_[t] = 0;  nanoseconds_[t] = 0; }
+  }
+
+  void count(int c) { counts_[c].fetch_add(1, std::memory_order_relaxed); }
+  void addTime(int t, long long ns) {
+    calls_[t].fetch_add(1, std::memory_order_relaxed);
+    nanoseconds_[t].fetch_add(ns, std::memory_order_relaxed);
+  }
+
+  // times one stage after the other, until stop() or the end of the scope
+  class Timer {
+   public:
+    Timer(CutFlowMonitor& monitor, int t):
+      monitor_(monitor), stage_(t), start_(std::chrono::steady_clock::now()) {}
+    ~Timer() { stop(); }
+    void next(int t) {
+      const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+      if (stage_ >= 0) monitor_.addTime(stage_, elapsed(now));
+      stage_ = t;
+      start_ = now;
+    }
+    void stop() { next(-1); }
+   private:
+    long long elapsed(std::chrono::steady_clock::time_point now) const {
+      return std::chrono::duration_cast<std::chrono::nanoseconds>(now - start_).count();
+    }
+    CutFlowMonitor& monitor_;
+    int stage_;
+    std::chrono::steady_clock::time_point start_;
+  };
+
+  void print(const std::string& title) const {
+    char line[200];
+    std::cout << "------------------------------------------------------------" << std::endl;
+    std::cout << title << ": cut flow" << std::endl;
+    const double first = counts_.empty() ? 0. : double(counts_[0]);
+    for (unsigned int c=0; c<counts_.size(); ++c) {
+      snprintf(line, sizeof(line), "  %-32s %12lld  %7.3f", counterNames_[c].c_str(),
+	      (long long) counts_[c], first > 0. ? counts_[c]/first : 0.);
+      std::cout << line << std::endl;
+    }
+    std::cout << title << ": timers" << std::endl;
+    for (unsigned int t=0; t<calls_.size(); ++t) {
+      const long long n = calls_[t];
+      const double total = double(nanoseconds_[t]);
+      snprintf(line, sizeof(line), "  %-32s %12lld calls %12.3f ms %12.1f ns/call",
+	      timerNames_[t].c_str(), n, 1.e-6*total, n > 0 ? total/n : 0.);
+      std::cout << line << std::endl;
+    }
+    std::cout << "------------------------------------------------------------" << std::endl;
+  }
+  bool write(const std::string& fileName) const {
+    std::ofstream out(fileName.c_str());
+    if (!out) return false;
+    for (unsigned int c=0; c<counts_.size(); ++c)
+      out << "counter\t" << counterNames_[c] << "\t" << counts_[c] << "\n";
+    for (unsigned int t=0; t<calls_.size(); ++t)
+      out << "timer\t" << timerNames_[t] << "\t" << calls_[t] << "\t"
+	  << nanoseconds_[t] << "\n";
+    return bool(out);
+  }
+  std::vector<std::pair<std::string, long long> > counters() const {
+    std::vector<std::pair<std::string, long long> > result;
+    for (unsigned int c=0; c<counts_.size(); ++c)
+      result.push_back(std::make_pair(counterNames_[c], (long long) counts_[c]));
+    return result;
+  }
+
+ private:
+  std::vector<std::string> counterNames_, timerNames_;
+  std::vector<std::atomic<long long> > counts_, calls_, nanoseconds_;
+};
+
+#else
+
+class CutFlowMonitor {
+ public:
+  static const bool enabled = false;
+  CutFlowMonitor(const std::vector<std::string>&, const std::vector<std::string>&) {}
+  void count(int) {}
+  void addTime(int, long long) {}
+  class Timer {
+   public:
+    Timer(CutFlowMonitor&, int) {}
+    void next(int) {}
+    void stop() {}
+  };
+  void print(const std::string&) const {}
+  bool write(const std::string&) const { return true; }
+  std::vector<std::pair<std::string, long long> > counters() const {
+    return std::vector<std::pair<std::string, long long> >();
+  }
+};
+
+#endif
+
+#endif
@@ -0,0 +1,47 @@
+#ifndef ElectronFeatureProducer_H
+#define ElectronFeatureProducer_H
+/*
+  ElectronFeatureProducer
+  =======================
+  Computes the ElectronFeatures of the electrons once per event and puts
+  them in the event, one ValueMap<float> per feature keyed on the input
+  electrons, instance label ElectronFeatures::name(f).
+
+  parameters:
+    src       the electrons (gsfElectrons)
+    beamSpot  for the transverse impact parameter (offlineBeamSpot)
+
+  Changes Log:
+  ------------
+  19.10.26: first version
+*/
+// system include files
+#include <memory>
+
+// user include files
+#include "FWCore/Framework/interface/Frameworkfwd.h"
+#include "FWCore/Framework/interface/global/EDProducer.h"
+#include "FWCore/Framework/interface/Event.h"
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "FWCore/Utilities/interface/EDGetToken.h"
+#include "FWCore/Utilities/interface/StreamID.h"
+
+#include "DataFormats/EgammaCandidates/interface/GsfElectronFwd.h"
+#include "DataFormats/BeamSpot/interface/BeamSpot.h"
+
+//
+// class decleration
+//
+class ElectronFeatureProducer : public edm::global::EDProducer<> {
+ public:
+  explicit ElectronFeatureProducer(const edm::ParameterSet&);
+  ~ElectronFeatureProducer();
+
+  virtual void produce(edm::StreamID, edm::Event&, const edm::EventSetup&) const;
+
+ private:
+  edm::EDGetTokenT<reco::GsfElectronCollection> electronToken_;
+  edm::EDGetTokenT<reco::BeamSpot> beamSpotToken_;
+};
+
+#endif
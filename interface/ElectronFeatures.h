@@ -0,0 +1,96 @@
+#ifndef ElectronFeatures_H
+#define ElectronFeatures_H
+/*
+  ElectronFeatures
+  ================
+  The electron variables that WenuPlots (cuts and VBTF tuples) and the
+  GenPurposeSkimmer probe loop all need: isolations, shower shape, track
+  matching, H/E, E/p, transverse impact parameter.
+
+  ElectronFeatureProducer computes them once per event for the
+  gsfElectrons and publishes one ValueMap<float> per feature, the feature
+  name (ElectronFeatures::name) being the instance label:
+      electronFeatures:trackIso03, electronFeatures:sigmaIetaIeta, ...
+
+  The consumers read them with an ElectronFeatureReader: the pat::Electron
+  is looked up through its originalObjectRef() in the maps. If the maps
+  are not configured or do not hold the electron (other input collection),
+  ElectronFeatures::compute is called instead, the same function that the
+  producer runs, so the values are the same either way.
+
+  Changes Log:
+  ------------
+  19.10.26: first version
+  19.10.26: the beam spot is read only when a feature is computed
+*/
+#include "FWCore/Framework/interface/Event.h"
+#include "FWCore/Framework/interface/ConsumesCollector.h"
+#include "FWCore/Utilities/interface/InputTag.h"
+#include "FWCore/Utilities/interface/EDGetToken.h"
+#include "DataFormats/Common/interface/Handle.h"
+#include "DataFormats/Common/interface/ValueMap.h"
+#include "DataFormats/EgammaCandidates/interface/GsfElectron.h"
+#include "DataFormats/PatCandidates/interface/Electron.h"
+#include "DataFormats/BeamSpot/interface/BeamSpot.h"
+
+class ElectronFeatures {
+ public:
+  enum Feature {
+    TRACK_ISO03 = 0,  // dr03 isolations, absolute
+    ECAL_ISO03,
+    HCAL_ISO03,       // depth1 + depth2
+    TRACK_ISO04,      // dr04 isolations, absolute
+    ECAL_ISO04,
+    HCAL_ISO04,
+    SIHIH,            // sigmaIetaIeta
+    SIGMAEE,          // sigmaEtaEta, eta corrected in the endcaps
+    DPHI_IN,
+    DETA_IN,
+    HOE,
+    EOP,              // E_SC/p_in
+    PIN,
+    POUT,
+    E1X5,
+    E2X5MAX,
+    E5X5,
+    TIP_BS,           // |dxy| of the gsf track to the beam spot
+    D0,               // d0 of the gsf track
+    NFEATURES
+  };
+  // the instance label of the ValueMap of feature f
+  static const char *name(int f);
+  // all the features of ele in f[NFEATURES]; beamSpot 0: dxy to (0,0)
+  static void compute(const reco::GsfElectron& ele, const reco::BeamSpot *beamSpot,
+		      float *f);
+};
+
+//
+// for the modules that read the features
+//
+class ElectronFeatureReader {
+ public:
+  // what is read once per event; the beam spot only by the first
+  // electron that is computed
+  struct Maps {
+    Maps(): valid(false), event(0), beamSpotRead(false), beamSpot(0) {}
+    bool valid;
+    edm::Handle<edm::ValueMap<float> > map[ElectronFeatures::NFEATURES];
+    const edm::Event *event;
+    mutable bool beamSpotRead;
+    mutable const reco::BeamSpot *beamSpot;
+  };
+  // src: the producer label, empty: always compute
+  ElectronFeatureReader(const edm::InputTag& src, const edm::InputTag& beamSpot,
+			edm::ConsumesCollector&& iC);
+
+  void getMaps(const edm::Event& evt, Maps& maps) const;
+  // the features of ele: from the maps if it is in there, else computed
+  void get(const Maps& maps, const pat::Electron& ele, float *f) const;
+
+ private:
+  bool useMaps_;
+  edm::EDGetTokenT<edm::ValueMap<float> > tokens_[ElectronFeatures::NFEATURES];
+  edm::EDGetTokenT<reco::BeamSpot> beamSpotToken_;
+};
+
+#endif
@@ -0,0 +1,80 @@
+#ifndef GenElectronMatcher_H
+#define GenElectronMatcher_H
+/*
+  GenElectronMatcher
+  ==================
+  Matches reconstructed objects to generator level electrons.
+
+  Once per event (setEvent) the status 1 electrons are copied out of the
+  GenParticleCollection into a small array that is sorted in eta. Every
+  probe then only visits the electrons inside its own eta window, which
+  is found with a binary search, instead of scanning the whole collection.
+  The phi difference is folded into [-pi, pi] so that the matching is
+  correct across the phi = +-pi boundary.
+
+  The mother of a matched electron is resolved only when it is asked for
+  (motherId) and is cached per event, so that events in which nobody
+  needs the mother information do not walk the decay tree.
+
+  Changes Log:
+  ------------
+  19.10.26: first version, replaces the per probe scan of the whole
+            GenParticleCollection in GenPurposeSkimmerData
+*/
+#include <vector>
+
+#include "DataFormats/HepMCCandidate/interface/GenParticle.h"
+#include "DataFormats/HepMCCandidate/interface/GenParticleFwd.h"
+
+//
+// result of the matching of one probe
+//
+struct GenElectronMatch {
+  int    nMatched;  // number of gen electrons inside the window
+  int    index;     // position in the sorted array of the closest one, -1 if none
+  double deta;      // gen - reco, of the closest gen electron
+  double dphi;      // gen - reco, folded into [-pi, pi]
+  double energy;    // energy of the closest gen electron
+};
+
+//
+// class decleration
+//
+class GenElectronMatcher {
+ public:
+  GenElectronMatcher(double maxDeta, double maxDphi);
+  ~GenElectronMatcher();
+
+  // build the sorted array of status 1 electrons for this event
+  void setEvent(const reco::GenParticleCollection& genParticles);
+  // windowed lookup: returns the number of gen electrons inside the window
+  int match(double eta, double phi, GenElectronMatch& result) const;
+  // pdgId of the first non electron ancestor of the matched gen electron
+  // 999 if there is no such ancestor (same convention as the old code)
+  int motherId(const GenElectronMatch& result) const;
+  int motherId(unsigned int i) const;
+  //
+  unsigned int size() const { return electrons_.size(); }
+  const reco::GenParticle& electron(unsigned int i) const;
+
+ private:
+  struct GenElectronEntry {
+    double eta;
+    double phi;
+    unsigned int key;   // index in the GenParticleCollection
+    bool operator<(const GenElectronEntry& other) const {
+      return eta < other.eta;
+    }
+  };
+  int resolveMotherId(const reco::GenParticle& electron) const;
+
+  double maxDeta_;
+  double maxDphi_;
+  const reco::GenParticleCollection *genParticles_;
+  std::vector<GenElectronEntry> electrons_;
+  // lazily filled mother pdgIds, one per entry of electrons_
+  mutable std::vector<int> motherIds_;
+  mutable std::vector<bool> motherResolved_;
+};
+
+#endif
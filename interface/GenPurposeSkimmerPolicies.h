@@ -0,0 +1,321 @@
+#ifndef GenPurposeSkimmerPolicies_H
+#define GenPurposeSkimmerPolicies_H
+/*
+  Policies for GenPurposeSkimmerT
+  ===============================
+  The skimmer template takes three policies as template arguments:
+
+  TruthPolicy       matching of the probes to gen level electrons
+  TriggerPolicy     where the trigger information comes from
+  AcceptancePolicy  gen level acceptance bookkeeping
+
+  Each policy keeps its configuration and the tokens of the collections
+  it reads; it is const after construction and shared by all the streams.
+  A nested Buffer keeps the per event variables that go to the probe_tree,
+  there is one per stream. A policy needs:
+
+    struct Policy {
+      struct Buffer { explicit Buffer(const Policy&); ... };
+      Policy(const edm::ParameterSet&, edm::ConsumesCollector&&);
+      void bookBranches(TTree*, Buffer&) const;
+      bool beginEvent(const edm::Event&, Buffer&) const; // false: skip event
+      void resetProbe(int probe, Buffer&) const;
+      void fillProbe(int probe, const pat::Electron&, Buffer&) const;
+    };
+
+  and an AcceptancePolicy also has keepsAllEvents. When it is true, every
+  event is written, even if it has no probe. An event for which a
+  beginEvent returns false is then written too: fillProbe of that policy
+  is not called, its probe fields keep the resetProbe defaults, and
+  beginEvent leaves its event fields at their defaults.
+
+  The "No..." policies are empty inline functions. In the data skimmer
+  they compile away, so its event loop has no MC tests and no gen arrays.
+
+  Changes Log:
+  ------------
+  19.10.26: first version
+  19.10.26: collections declared with consumes, buffers are per stream
+  19.10.26: GenElectronAcceptance resets its fields before it reads the
+            gen particles
+*/
+#include <vector>
+
+#include "FWCore/Framework/interface/Event.h"
+#include "FWCore/Framework/interface/ConsumesCollector.h"
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "FWCore/Utilities/interface/InputTag.h"
+#include "FWCore/Utilities/interface/EDGetToken.h"
+#include "DataFormats/Common/interface/Handle.h"
+#include "DataFormats/HLTReco/interface/TriggerEvent.h"
+#include "DataFormats/HLTReco/interface/TriggerObject.h"
+#include "DataFormats/PatCandidates/interface/Electron.h"
+#include "DataFormats/Math/interface/deltaR.h"
+#include "ElectroWeakAnalysis/WENu/interface/GenElectronMatcher.h"
+
+#include "TTree.h"
+#include "TMath.h"
+
+// ****************************************************************************
+// Truth matching
+// ****************************************************************************
+//
+// no truth matching: data
+class NoTruthMatching {
+ public:
+  struct Buffer { explicit Buffer(const NoTruthMatching&) {} };
+  NoTruthMatching(const edm::ParameterSet&, edm::ConsumesCollector&&) {}
+  void bookBranches(TTree*, Buffer&) const {}
+  bool beginEvent(const edm::Event&, Buffer&) const { return true; }
+  void resetProbe(int, Buffer&) const {}
+  void fillProbe(int, const pat::Electron&, Buffer&) const {}
+};
+//
+// match the probes to the status 1 gen electrons (GenElectronMatcher)
+class GenElectronTruthMatching {
+ public:
+  struct Buffer {
+    explicit Buffer(const GenElectronTruthMatching& p):
+      matcher(p.MCMatch_Deta_, p.MCMatch_Dphi_) {}
+    GenElectronMatcher matcher;
+    int probe_mc_matched[4];
+    double probe_mc_matched_deta[4];
+    double probe_mc_matched_dphi[4];
+    double probe_mc_matched_denergy[4];
+    int probe_mc_matched_mother[4];
+  };
+  GenElectronTruthMatching(const edm::ParameterSet& ps,
+			   edm::ConsumesCollector&& iC) {
+    MCCollection_ = ps.getUntrackedParameter<edm::InputTag>("MCCollection");
+    MCToken_ = iC.consumes<reco::GenParticleCollection>(MCCollection_);
+    MCMatch_Deta_ = ps.getUntrackedParameter<double>("MCMatch_Deta",0.1);
+    MCMatch_Dphi_ = ps.getUntrackedParameter<double>("MCMatch_Dphi",0.35);
+  }
+  void bookBranches(TTree *probe_tree, Buffer& b) const {
+    probe_tree->Branch("probe_mc_matched",b.probe_mc_matched,"probe_mc_matched[4]/I");
+    probe_tree->Branch("probe_mc_matched_deta",b.probe_mc_matched_deta,
+		       "probe_mc_matched_deta[4]/D");
+    probe_tree->Branch("probe_mc_matched_dphi",b.probe_mc_matched_dphi,
+		       "probe_mc_matched_dphi[4]/D");
+    probe_tree->Branch("probe_mc_matched_denergy",b.probe_mc_matched_denergy,
+		       "probe_mc_matched_denergy[4]/D");
+    probe_tree->Branch("probe_mc_matched_mother",b.probe_mc_matched_mother,
+		       "probe_mc_matched_mother[4]/I");
+  }
+  bool beginEvent(const edm::Event& evt, Buffer& b) const {
+    // the status 1 electrons are sorted in eta once here, the probes
+    // do windowed lookups in them later on
+    edm::Handle<reco::GenParticleCollection> pGenPart;
+    evt.getByToken(MCToken_, pGenPart);
+    if ( not  pGenPart.isValid() ) {
+      std::cout <<"Error! Can't get "<<MCCollection_.label() << std::endl;
+      return false;
+    }
+    b.matcher.setEvent(*pGenPart);
+    return true;
+  }
+  void resetProbe(int i, Buffer& b) const {
+    b.probe_mc_matched[i] = 0;
+    b.probe_mc_matched_deta[i] = 999.;
+    b.probe_mc_matched_dphi[i] = 999.;
+    b.probe_mc_matched_denergy[i] = 999.;
+    b.probe_mc_matched_mother[i] = 999;
+  }
+  void fillProbe(int i, const pat::Electron& probeEle, Buffer& b) const {
+    // only the gen electrons in the eta window of the probe are visited
+    // and the mother is looked up only for the matched one
+    GenElectronMatch mcMatch;
+    if (b.matcher.match(probeEle.eta(), probeEle.phi(), mcMatch) == 0) return;
+    b.probe_mc_matched[i] = mcMatch.nMatched;
+    b.probe_mc_matched_deta[i] = mcMatch.deta;
+    b.probe_mc_matched_dphi[i] = mcMatch.dphi;
+    b.probe_mc_matched_denergy[i] = mcMatch.energy - probeEle.caloEnergy();
+    b.probe_mc_matched_mother[i] = b.matcher.motherId(mcMatch);
+  }
+ private:
+  edm::InputTag MCCollection_;
+  edm::EDGetTokenT<reco::GenParticleCollection> MCToken_;
+  double MCMatch_Deta_;
+  double MCMatch_Dphi_;
+};
+
+// ****************************************************************************
+// Trigger source
+// ****************************************************************************
+//
+// no trigger information: e.g. gen level studies on samples without HLT
+class NoTriggerSource {
+ public:
+  struct Buffer { explicit Buffer(const NoTriggerSource&) {} };
+  NoTriggerSource(const edm::ParameterSet&, edm::ConsumesCollector&&) {}
+  void bookBranches(TTree*, Buffer&) const {}
+  bool beginEvent(const edm::Event&, Buffer&) const { return true; }
+  void resetProbe(int, Buffer&) const {}
+  void fillProbe(int, const pat::Electron&, Buffer&) const {}
+};
+//
+// the AOD trigger summary: events without it are skipped. If a list of
+// HLT filters is given (HLTFilterType), each probe is matched in deltaR
+// to the objects of each filter
+class TriggerSummaryAODSource {
+ public:
+  enum { MAX_FILTERS = 25 };
+  struct Buffer {
+    explicit Buffer(const TriggerSummaryAODSource&) {}
+    edm::Handle<trigger::TriggerEvent> pHLT;
+    int probe_pass_trigger_cut[4][MAX_FILTERS];
+  };
+  TriggerSummaryAODSource(const edm::ParameterSet& ps,
+			  edm::ConsumesCollector&& iC) {
+    HLTCollection_ = ps.getUntrackedParameter<edm::InputTag>("HLTCollectionE29");
+    HLTToken_ = iC.consumes<trigger::TriggerEvent>(HLTCollection_);
+    ProbeHLTObjMaxDR = ps.getUntrackedParameter<double>("ProbeHLTObjMaxDR",0.2);
+    HLTFilterType_ = ps.getUntrackedParameter<std::vector<edm::InputTag> >
+      ("HLTFilterType", std::vector<edm::InputTag>());
+    if (HLTFilterType_.size() > MAX_FILTERS) {
+      std::cout << "Warning: only the first " << int(MAX_FILTERS)
+		<< " HLT filters are matched to the probes" << std::endl;
+      HLTFilterType_.resize(MAX_FILTERS);
+    }
+  }
+  void bookBranches(TTree *probe_tree, Buffer& b) const {
+    if (HLTFilterType_.empty()) return;
+    probe_tree->Branch("probe_trigger_cut",b.probe_pass_trigger_cut,
+		       "probe_trigger_cut[4][25]/I");
+  }
+  bool beginEvent(const edm::Event& evt, Buffer& b) const {
+    evt.getByToken(HLTToken_, b.pHLT);
+    if (not b.pHLT.isValid()){
+      std::cout << "Error!!! HLT is missing!" << std::endl;
+      return false;
+    }
+    return true;
+  }
+  void resetProbe(int i, Buffer& b) const {
+    for (int j=0; j<MAX_FILTERS; ++j) b.probe_pass_trigger_cut[i][j] = 0;
+  }
+  void fillProbe(int i, const pat::Electron& probeEle, Buffer& b) const {
+    const int nF(b.pHLT->sizeFilters());
+    const trigger::TriggerObjectCollection& TOC(b.pHLT->getObjects());
+    const int nFilters = HLTFilterType_.size();
+    for (int filterNum=0; filterNum<nFilters; ++filterNum) {
+      const int iF = b.pHLT->filterIndex(HLTFilterType_[filterNum]);
+      if (nF == iF) continue;
+      // HLT matching is with an HLT object and we don't care what it is
+      const trigger::Keys& KEYS(b.pHLT->filterKeys(iF));
+      const int nK(KEYS.size());
+      for (int iTrig = 0;iTrig <nK; ++iTrig ) {
+	const trigger::TriggerObject& TO(TOC[KEYS[iTrig]]);
+	double dr_ele_HLT =
+	  reco::deltaR(probeEle.eta(), probeEle.phi(), TO.eta(), TO.phi());
+	if (fabs(dr_ele_HLT) < ProbeHLTObjMaxDR) {
+	  b.probe_pass_trigger_cut[i][filterNum] = 1;
+	  break;
+	}
+      }
+    }
+  }
+ private:
+  edm::InputTag HLTCollection_;
+  edm::EDGetTokenT<trigger::TriggerEvent> HLTToken_;
+  std::vector<edm::InputTag> HLTFilterType_;
+  double ProbeHLTObjMaxDR;
+};
+
+// ****************************************************************************
+// Acceptance bookkeeping
+// ****************************************************************************
+//
+// no acceptance information: only events with probes are kept
+class NoAcceptanceBookkeeping {
+ public:
+  static const bool keepsAllEvents = false;
+  struct Buffer { explicit Buffer(const NoAcceptanceBookkeeping&) {} };
+  NoAcceptanceBookkeeping(const edm::ParameterSet&, edm::ConsumesCollector&&) {}
+  void bookBranches(TTree*, Buffer&) const {}
+  bool beginEvent(const edm::Event&, Buffer&) const { return true; }
+  void resetProbe(int, Buffer&) const {}
+  void fillProbe(int, const pat::Electron&, Buffer&) const {}
+};
+//
+// the 10 highest ET status 1 gen electrons of every event
+class GenElectronAcceptance {
+ public:
+  static const bool keepsAllEvents = true;
+  enum { MAX_MC_ELECTRONS = 10 };
+  struct Buffer {
+    explicit Buffer(const GenElectronAcceptance&): genElectrons(0., 0.) {}
+    GenElectronMatcher genElectrons;
+    int      mc_ele_number;
+    double   mc_ele_eta[MAX_MC_ELECTRONS];
+    double   mc_ele_phi[MAX_MC_ELECTRONS];
+    double   mc_ele_et[MAX_MC_ELECTRONS];
+    double   mc_ele_vertex_x[MAX_MC_ELECTRONS];
+    double   mc_ele_vertex_y[MAX_MC_ELECTRONS];
+    double   mc_ele_vertex_z[MAX_MC_ELECTRONS];
+    int      mc_ele_mother[MAX_MC_ELECTRONS];
+    int      mc_ele_charge[MAX_MC_ELECTRONS];
+    int      mc_ele_status[MAX_MC_ELECTRONS];
+  };
+  GenElectronAcceptance(const edm::ParameterSet& ps,
+			edm::ConsumesCollector&& iC) {
+    MCCollection_ = ps.getUntrackedParameter<edm::InputTag>("MCCollection");
+    MCToken_ = iC.consumes<reco::GenParticleCollection>(MCCollection_);
+  }
+  void bookBranches(TTree *probe_tree, Buffer& b) const {
+    probe_tree->Branch("mc_ele_number", &b.mc_ele_number, "mc_ele_number/I");
+    probe_tree->Branch("mc_ele_eta", b.mc_ele_eta, "mc_ele_eta[10]/D");
+    probe_tree->Branch("mc_ele_phi", b.mc_ele_phi, "mc_ele_phi[10]/D");
+    probe_tree->Branch("mc_ele_et",  b.mc_ele_et,  "mc_ele_et[10]/D");
+    probe_tree->Branch("mc_ele_vertex_x", b.mc_ele_vertex_x, "mc_ele_vertex_x[10]/D");
+    probe_tree->Branch("mc_ele_vertex_y", b.mc_ele_vertex_y, "mc_ele_vertex_y[10]/D");
+    probe_tree->Branch("mc_ele_vertex_z", b.mc_ele_vertex_z, "mc_ele_vertex_z[10]/D");
+    probe_tree->Branch("mc_ele_mother", b.mc_ele_mother, "mc_ele_mother[10]/I");
+    probe_tree->Branch("mc_ele_charge", b.mc_ele_charge, "mc_ele_charge[10]/I");
+    probe_tree->Branch("mc_ele_status", b.mc_ele_status, "mc_ele_status[10]/I");
+  }
+  bool beginEvent(const edm::Event& evt, Buffer& b) const {
+    // the defaults first: the event is written even without gen particles
+    b.mc_ele_number = 0;
+    for (int i=0; i<MAX_MC_ELECTRONS; ++i) {
+      b.mc_ele_eta[i] = -999.;  b.mc_ele_phi[i] = -999.; b.mc_ele_et[i] = -999.;
+      b.mc_ele_vertex_x[i] = -999.; b.mc_ele_vertex_y[i] = -999.;
+      b.mc_ele_vertex_z[i] = -999.;
+      b.mc_ele_mother[i] = 999; b.mc_ele_charge[i] = -99;
+      b.mc_ele_status[i] = -99;
+    }
+    edm::Handle<reco::GenParticleCollection> pGenPart;
+    evt.getByToken(MCToken_, pGenPart);
+    if ( not  pGenPart.isValid() ) {
+      std::cout <<"Error! Can't get "<<MCCollection_.label() << std::endl;
+      return false;
+    }
+    b.genElectrons.setEvent(*pGenPart);
+    const int n = b.genElectrons.size();
+    b.mc_ele_number = n;
+    if (n == 0) return true;
+    // keep the highest ET ones
+    std::vector<double> et(n);
+    std::vector<int> sorted(n);
+    for (int i=0; i<n; ++i) et[i] = b.genElectrons.electron(i).et();
+    TMath::Sort(n, &et[0], &sorted[0], true);
+    for (int i=0; i<n && i<MAX_MC_ELECTRONS; ++i) {
+      const reco::GenParticle& gen = b.genElectrons.electron(sorted[i]);
+      b.mc_ele_eta[i] = gen.eta();  b.mc_ele_phi[i] = gen.phi();
+      b.mc_ele_et[i]  = gen.et();
+      b.mc_ele_vertex_x[i] = gen.vx(); b.mc_ele_vertex_y[i] = gen.vy();
+      b.mc_ele_vertex_z[i] = gen.vz();
+      b.mc_ele_mother[i] = b.genElectrons.motherId(sorted[i]);
+      b.mc_ele_charge[i] = gen.charge();
+      b.mc_ele_status[i] = gen.status();
+    }
+    return true;
+  }
+  void resetProbe(int, Buffer&) const {}
+  void fillProbe(int, const pat::Electron&, Buffer&) const {}
+ private:
+  edm::InputTag MCCollection_;
+  edm::EDGetTokenT<reco::GenParticleCollection> MCToken_;
+};
+
+#endif
@@ -0,0 +1,84 @@
+#ifndef GenPurposeSkimmerRow_H
+#define GenPurposeSkimmerRow_H
+/*
+  GenPurposeSkimmerRow
+  ====================
+  The variables of one entry of the probe_tree that are common to all
+  the GenPurposeSkimmer variants (data, MC, acceptance). The gen level
+  and trigger matching variables live in the buffers of the policies
+  (see GenPurposeSkimmerPolicies.h).
+
+  Changes Log:
+  ------------
+  19.10.26: first version, taken out of GenPurposeSkimmerData.h
+  19.10.26: run, lumi and event number, to order the stream outputs
+*/
+#include "TTree.h"
+
+struct GenPurposeSkimmerRow {
+  enum { MAX_PROBES = 4, MAX_SC = 5, MAX_TRACKS = 20, MAX_MUONS = 4 };
+
+  void book(TTree *probe_tree);
+  void resetProbes();
+
+  //probe SC variables
+  double probe_sc_eta_for_tree[MAX_PROBES];
+  double probe_sc_phi_for_tree[MAX_PROBES];
+  double probe_sc_et_for_tree[MAX_PROBES];
+  int probe_sc_pass_fiducial_cut[MAX_PROBES];
+
+  //probe electron variables
+  double probe_ele_eta_for_tree[MAX_PROBES];
+  double probe_ele_phi_for_tree[MAX_PROBES];
+  double probe_ele_et_for_tree[MAX_PROBES];
+  double probe_ele_Xvertex_for_tree[MAX_PROBES];
+  double probe_ele_Yvertex_for_tree[MAX_PROBES];
+  double probe_ele_Zvertex_for_tree[MAX_PROBES];
+  double probe_ele_tip[MAX_PROBES];
+  int probe_charge_for_tree[MAX_PROBES];
+  int probe_classification_index_for_tree[MAX_PROBES];
+  //
+  double probe_isolation_value[MAX_PROBES];
+  double probe_iso_user[MAX_PROBES];
+  double probe_ecal_isolation_value[MAX_PROBES];
+  double probe_ecal_iso_user[MAX_PROBES];
+  double probe_hcal_isolation_value[MAX_PROBES];
+  double probe_hcal_iso_user[MAX_PROBES];
+  //
+  double probe_ele_hoe[MAX_PROBES];
+  double probe_ele_shh[MAX_PROBES];
+  double probe_ele_sihih[MAX_PROBES];
+  double probe_ele_dhi[MAX_PROBES];
+  double probe_ele_dfi[MAX_PROBES];
+  double probe_ele_eop[MAX_PROBES];
+  double probe_ele_pin[MAX_PROBES];
+  double probe_ele_pout[MAX_PROBES];
+  double probe_ele_e5x5[MAX_PROBES];
+  double probe_ele_e2x5[MAX_PROBES];
+  double probe_ele_e1x5[MAX_PROBES];
+
+  //event variables
+  unsigned int event_run, event_lumi;
+  unsigned long long event_number;
+  int elec_number_in_event;
+  int elec_1_duplicate_removal;
+
+  double event_MET, event_MET_sig, event_MET_phi;
+  double event_tcMET, event_tcMET_sig, event_tcMET_phi;
+  double event_pfMET, event_pfMET_sig, event_pfMET_phi;
+  double event_t1MET, event_t1MET_phi, event_t1MET_sig;
+  double event_mcMET, event_mcMET_phi, event_mcMET_sig;
+  //
+  double sc_hybrid_et[MAX_SC], sc_hybrid_eta[MAX_SC], sc_hybrid_phi[MAX_SC];
+  double sc_multi5x5_et[MAX_SC], sc_multi5x5_eta[MAX_SC], sc_multi5x5_phi[MAX_SC];
+  //
+  double ctf_track_pt[MAX_TRACKS], ctf_track_eta[MAX_TRACKS], ctf_track_phi[MAX_TRACKS];
+  double ctf_track_vx[MAX_TRACKS], ctf_track_vy[MAX_TRACKS], ctf_track_vz[MAX_TRACKS];
+  double ctf_track_tip[MAX_TRACKS],  ctf_track_tip_bs[MAX_TRACKS];
+  //
+  double muon_pt[MAX_MUONS], muon_eta[MAX_MUONS], muon_phi[MAX_MUONS];
+  double muon_vx[MAX_MUONS], muon_vy[MAX_MUONS], muon_vz[MAX_MUONS];
+  double muon_tip[MAX_MUONS],  muon_tip_bs[MAX_MUONS];
+};
+
+#endif
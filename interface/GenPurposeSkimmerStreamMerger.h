@@ -0,0 +1,65 @@
+#ifndef GenPurposeSkimmerStreamMerger_H
+#define GenPurposeSkimmerStreamMerger_H
+/*
+  GenPurposeSkimmerStreamMerger
+  =============================
+  In multi-threaded jobs every stream of the GenPurposeSkimmerT writes
+  its own probe_tree to outputfile_stream<N>.root. At the end of the job
+  the stream files are either
+
+  merge():      copied into the outputfile in (run, lumi, event) order;
+                the stream files are removed afterwards
+  writeIndex(): kept, and the outputfile gets a TTree "stream_index"
+                with run, lumi, event, file and entry of every event,
+                in (run, lumi, event) order. The names of the stream
+                files are in the UserInfo of the index tree, "file" is
+                the position in that list.
+
+  In both cases the result does not depend on the number of streams or
+  on which stream got which event.
+
+  Changes Log:
+  ------------
+  19.10.26: first version
+*/
+#include <mutex>
+#include <string>
+#include <vector>
+
+class GenPurposeSkimmerStreamMerger {
+ public:
+  explicit GenPurposeSkimmerStreamMerger(const std::string& outputFile);
+  //
+  // the file name of the tree of stream i
+  std::string streamFileName(unsigned int stream) const;
+  // called by each stream once its file is closed (thread safe)
+  void addStreamFile(unsigned int stream, const std::string& fileName);
+  //
+  // end of job: false if there is nothing to write
+  bool merge();
+  bool writeIndex();
+
+ private:
+  struct Entry {
+    unsigned int run, lumi;
+    unsigned long long event;
+    int file;
+    long long entry;
+    bool operator<(const Entry& e) const {
+      if (run != e.run) return run < e.run;
+      if (lumi != e.lumi) return lumi < e.lumi;
+      if (event != e.event) return event < e.event;
+      // same event in two streams: should not happen, keep it stable
+      if (file != e.file) return file < e.file;
+      return entry < e.entry;
+    }
+  };
+  void sortedEntries(std::vector<Entry>& entries) const;
+
+  std::string outputFile_;
+  std::mutex mutex_;
+  std::vector<unsigned int> streams_;
+  std::vector<std::string> files_;
+};
+
+#endif
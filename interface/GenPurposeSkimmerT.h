@@ -0,0 +1,180 @@
+#ifndef GenPurposeSkimmerT_H
+#define GenPurposeSkimmerT_H
+/*
+  GenPurposeSkimmerT
+  ==================
+  General purpose skimmer: keeps the analysis relevant information of
+  the 4 highest ET electrons (probes) and of the event in a flat TTree.
+
+  The data, MC and acceptance versions of the skimmer only differ in the
+  gen level and trigger information they store. They are instances of
+  this template with different policies (GenPurposeSkimmerPolicies.h):
+
+    GenPurposeSkimmerData       : NoTruthMatching, TriggerSummaryAODSource,
+                                  NoAcceptanceBookkeeping
+    GenPurposeSkimmer           : GenElectronTruthMatching, TriggerSummaryAODSource,
+                                  NoAcceptanceBookkeeping
+    GenPurposeSkimmerAcceptance : GenElectronTruthMatching, TriggerSummaryAODSource,
+                                  GenElectronAcceptance
+
+  Multi-threaded jobs: the skimmer is a global module. Each stream fills
+  its own probe_tree (the GenPurposeSkimmerRow and the policy buffers
+  are in the stream cache) in outputfile_stream<N>.root. At the end of
+  the job (GenPurposeSkimmerStreamMerger):
+    mergeStreamOutputs = True  (default): the stream trees are merged in
+                         outputfile in (run, lumi, event) order
+    mergeStreamOutputs = False: the stream files are kept and outputfile
+                         has the (run, lumi, event) ordered index of them
+
+  Changes Log:
+  ------------
+  19.10.26: first version, from GenPurposeSkimmerData
+  19.10.26: global module with one probe_tree per stream
+  19.10.26: probe variables from the ElectronFeatures maps
+            (electronFeatures, computed here if not given)
+  19.10.26: electron and supercluster ET in one WenuKinematics call each
+  19.10.26: cut flow counters and stage timers (CutFlowMonitor), compiled
+            in with WENU_CUTFLOW, summary and cutFlowFile at endJob
+  19.10.26: event loop messages through WenuDiagnostics (diagnosticsEvery,
+            diagnosticsLimit)
+  19.10.26: with keepsAllEvents, an event without the gen or trigger
+            collection is written with their defaults, and counted
+*/
+// system include files
+#include <memory>
+#include <string>
+
+// user include files
+#include "FWCore/Framework/interface/Frameworkfwd.h"
+#include "FWCore/Framework/interface/global/EDAnalyzer.h"
+#include "FWCore/Utilities/interface/StreamID.h"
+#include "FWCore/Utilities/interface/EDGetToken.h"
+
+#include "FWCore/Framework/interface/Event.h"
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "FWCore/MessageLogger/interface/MessageLogger.h"
+
+// root + maths
+#include "TFile.h"
+#include "TTree.h"
+#include "TString.h"
+#include "TMath.h"
+//
+#include "DataFormats/Math/interface/Point3D.h"
+#include "DataFormats/PatCandidates/interface/Electron.h"
+#include "DataFormats/PatCandidates/interface/MET.h"
+#include "DataFormats/PatCandidates/interface/Muon.h"
+#include "DataFormats/METReco/interface/CaloMETFwd.h"
+#include "DataFormats/METReco/interface/PFMETFwd.h"
+#include "DataFormats/METReco/interface/METFwd.h"
+#include "DataFormats/TrackReco/interface/TrackFwd.h"
+#include "DataFormats/EgammaReco/interface/SuperClusterFwd.h"
+#include "DataFormats/BeamSpot/interface/BeamSpot.h"
+//
+#include "ElectroWeakAnalysis/WENu/interface/GenPurposeSkimmerRow.h"
+#include "ElectroWeakAnalysis/WENu/interface/GenPurposeSkimmerPolicies.h"
+#include "ElectroWeakAnalysis/WENu/interface/GenPurposeSkimmerStreamMerger.h"
+#include "ElectroWeakAnalysis/WENu/interface/ElectronFeatures.h"
+#include "ElectroWeakAnalysis/WENu/interface/CutFlowMonitor.h"
+#include "ElectroWeakAnalysis/WENu/interface/WenuDiagnostics.h"
+//
+// what each stream fills: its own file, tree and branch variables
+//
+template <class TruthPolicy, class TriggerPolicy, class AcceptancePolicy>
+struct GenPurposeSkimmerStream {
+  GenPurposeSkimmerStream(const TruthPolicy& truth, const TriggerPolicy& trigger,
+			  const AcceptancePolicy& acceptance):
+    histofile(0), probe_tree(0), tree_fills(0),
+    truthBuffer(truth), triggerBuffer(trigger), acceptanceBuffer(acceptance) {}
+  std::string fileName;
+  TFile * histofile;
+  TTree * probe_tree;
+  int tree_fills;
+  GenPurposeSkimmerRow row;
+  typename TruthPolicy::Buffer      truthBuffer;
+  typename TriggerPolicy::Buffer    triggerBuffer;
+  typename AcceptancePolicy::Buffer acceptanceBuffer;
+};
+//
+// class decleration
+//
+
+template <class TruthPolicy, class TriggerPolicy, class AcceptancePolicy>
+class GenPurposeSkimmerT : public edm::global::EDAnalyzer<
+  edm::StreamCache<GenPurposeSkimmerStream<TruthPolicy, TriggerPolicy, AcceptancePolicy> > > {
+   public:
+      typedef GenPurposeSkimmerStream<TruthPolicy, TriggerPolicy, AcceptancePolicy> Stream;
+      explicit GenPurposeSkimmerT(const edm::ParameterSet&);
+      ~GenPurposeSkimmerT();
+
+
+   private:
+      virtual std::unique_ptr<Stream> beginStream(edm::StreamID) const;
+      virtual void analyze(edm::StreamID, const edm::Event&, const edm::EventSetup&) const;
+      virtual void endStream(edm::StreamID) const;
+      virtual void endJob() ;
+      //
+      void fillMETVariables(const edm::Event&, GenPurposeSkimmerRow&) const;
+      int  fillSuperClusterVariables(const edm::Event&, GenPurposeSkimmerRow&) const;
+      int  fillTrackVariables(const edm::Event&, const math::XYZPoint&,
+			      GenPurposeSkimmerRow&) const;
+      void fillMuonVariables(const edm::Event&, const math::XYZPoint&,
+			     GenPurposeSkimmerRow&) const;
+      bool PassFiducialCut(double scEta) const;
+
+      // ----------member data ---------------------------
+
+  std::string outputFile_;
+  bool mergeStreamOutputs_;
+  // the streams hand their files over at endStream
+  mutable GenPurposeSkimmerStreamMerger merger_;
+
+  edm::InputTag ElectronCollection_;
+  edm::InputTag MetCollectionTag_;
+  edm::InputTag mcMetCollectionTag_;
+  edm::InputTag tcMetCollectionTag_;
+  edm::InputTag pfMetCollectionTag_;
+  edm::InputTag t1MetCollectionTag_;
+  edm::InputTag ctfTracksTag_;
+  edm::InputTag corHybridsc_, multi5x5sc_;
+
+  edm::EDGetTokenT<pat::ElectronCollection> ElectronToken_;
+  edm::EDGetTokenT<reco::CaloMETCollection> MetToken_;
+  edm::EDGetTokenT<pat::METCollection>      mcMetToken_;
+  edm::EDGetTokenT<reco::METCollection>     tcMetToken_;
+  edm::EDGetTokenT<reco::PFMETCollection>   pfMetToken_;
+  edm::EDGetTokenT<pat::METCollection>      t1MetToken_;
+  edm::EDGetTokenT<reco::TrackCollection>   ctfTracksToken_;
+  edm::EDGetTokenT<reco::SuperClusterCollection> corHybridscToken_, multi5x5scToken_;
+  edm::EDGetTokenT<reco::BeamSpot>          beamSpotToken_;
+  edm::EDGetTokenT<pat::MuonCollection>     muonToken_;
+  //
+  // policies: configuration only, their per event variables are in Stream
+  TruthPolicy      truth_;
+  TriggerPolicy    trigger_;
+  AcceptancePolicy acceptance_;
+  // the probe variables: ElectronFeatureProducer maps or computed
+  ElectronFeatureReader features_;
+
+  double BarrelMaxEta;
+  double EndcapMinEta;
+  double EndcapMaxEta;
+
+  bool skipEventsWithoutProbe_;
+  double ProbeSCMinEt;
+  //
+  // cut flow and timers, shared by the streams (atomic)
+  enum { CF_EVENTS = 0, CF_ELECTRONS, CF_PROBE, CF_ACCEPTANCE, CF_TRUTH,
+	 CF_TRIGGER, CF_SC_OR_TRACKS, CF_WRITTEN };
+  enum { T_FETCH = 0, T_SELECTION, T_COLLECTIONS, T_FEATURES, T_FILL };
+  std::unique_ptr<CutFlowMonitor> cutFlow_;
+  std::string cutFlowFile_;
+  // event loop messages, shared by the streams (atomic)
+  std::unique_ptr<WenuDiagnostics> diag_;
+  int msgNoSC_;
+  int msgIncomplete_;
+};
+
+#include "ElectroWeakAnalysis/WENu/interface/GenPurposeSkimmerT.icc"
+
+#endif
@@ -0,0 +1,83 @@
+#ifndef HistogramSnapshotServer_H
+#define HistogramSnapshotServer_H
+/*
+  HistogramSnapshotServer
+  =======================
+  Read-only copies of the histograms and counters of a running job,
+  served over HTTP on localhost, to look at a long job before its endJob:
+
+    curl http://localhost:<port>/
+
+  The event loop makes a HistogramSnapshot from time to time (every
+  snapshotEvery events in WenuPlots) and publishes it, an atomic swap of
+  a shared_ptr: the event loop never waits for the server. The server
+  thread answers with the last published snapshot, which it holds while
+  it writes it; a snapshot is never changed, so every answer has all the
+  histograms and counters of the same event.
+
+  The answer is text, one line per item:
+    snapshot <module> events <n> time <unix time>
+    counter <name> <count>
+    histogram <name> <nbins> <low> <high> <entries> <mean> <rms>
+    bins <underflow> <bin 1> ... <bin nbins> <overflow>
+  and "503 no snapshot yet" before the first one. Only 127.0.0.1 is
+  bound; if the port cannot be bound the job runs without the server.
+  A client that stops reading is dropped after 1 s, so the destructor
+  never waits longer than that for the server thread.
+
+  Changes Log:
+  ------------
+  19.10.26: first version
+  19.10.26: send timeout, shutdown of the socket before the join
+*/
+#include <atomic>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "TH1.h"
+
+struct HistogramSnapshot {
+  struct Histogram {
+    std::string name;
+    int nbins;
+    double low, high, entries, mean, rms;
+    std::vector<double> contents;    // underflow, bins, overflow
+  };
+  HistogramSnapshot(): events(0), time(0) {}
+  // a copy of h
+  void add(const TH1 *h);
+  void write(std::ostream& out, const std::string& module) const;
+
+  long long events;
+  long long time;
+  std::vector<std::pair<std::string, long long> > counters;
+  std::vector<Histogram> histograms;
+};
+
+class HistogramSnapshotServer {
+ public:
+  // port 0: no server
+  HistogramSnapshotServer(const std::string& module, int port);
+  ~HistogramSnapshotServer();
+  bool running() const { return socket_ >= 0; }
+  // the snapshot of the next answers
+  void publish(std::shared_ptr<const HistogramSnapshot> snapshot);
+
+ private:
+  HistogramSnapshotServer(const HistogramSnapshotServer&);
+  HistogramSnapshotServer& operator=(const HistogramSnapshotServer&);
+  void serve();
+  void answer(int connection);
+
+  std::string module_;
+  int socket_;
+  std::atomic<bool> stop_;
+  std::shared_ptr<const HistogramSnapshot> current_;   // atomic_load/store only
+  std::thread thread_;
+};
+
+#endif
@@ -0,0 +1,85 @@
+#ifndef ImpactParameterBatch_H
+#define ImpactParameterBatch_H
+/*
+  ImpactParameterBatch
+  ====================
+  Transverse impact parameter of a batch of tracks, with respect to the
+  origin and to the beam spot, with the definition of reco::TrackBase:
+
+    dxy(p) = ( -(vx - p.x)*py + (vy - p.y)*px ) / pt
+
+  The vertex and momentum components of the selected tracks are copied
+  into one array each (structure of arrays), so that the loop in
+  compute() has no branches and no indirection and is vectorized by the
+  compiler (2 or 4 tracks per instruction with SSE2/AVX). This replaces
+  the two dxy() calls per stored track on the full track objects.
+
+  Usage:
+    ImpactParameterBatch<20> batch;
+    batch.push_back(tr.vx(), tr.vy(), tr.px(), tr.py());   // n times
+    batch.compute(bspot.x(), bspot.y());
+    batch.dxy(i), batch.dxyBeamSpot(i)
+
+  Header only, so that it can also be used outside of the plugin (see
+  bin/benchImpactParameterBatch.cpp).
+
+  Changes Log:
+  ------------
+  19.10.26: first version
+*/
+#include <cmath>
+
+//
+// the kernel: n tracks, plain arrays
+//
+inline void
+impactParameterBatch(int n, const double * __restrict__ vx,
+		     const double * __restrict__ vy,
+		     const double * __restrict__ px,
+		     const double * __restrict__ py,
+		     double bx, double by,
+		     double * __restrict__ dxy, double * __restrict__ dxyBs)
+{
+  for (int i=0; i<n; ++i) {
+    const double invPt = 1./std::sqrt(px[i]*px[i] + py[i]*py[i]);
+    const double d0 = -vx[i]*py[i] + vy[i]*px[i];
+    dxy[i]   = d0*invPt;
+    // the beam spot part is the same for all the tracks but px, py
+    dxyBs[i] = (d0 + bx*py[i] - by*px[i])*invPt;
+  }
+}
+
+//
+// the SoA buffer for at most N tracks
+//
+template <int N>
+class ImpactParameterBatch {
+ public:
+  ImpactParameterBatch(): n_(0) {}
+  void clear() { n_ = 0; }
+  int size() const { return n_; }
+  bool full() const { return n_ == N; }
+  // false if the batch is full
+  bool push_back(double vx, double vy, double px, double py) {
+    if (n_ == N) return false;
+    vx_[n_] = vx;  vy_[n_] = vy;  px_[n_] = px;  py_[n_] = py;
+    ++n_;
+    return true;
+  }
+  void compute(double bx, double by) {
+    impactParameterBatch(n_, vx_, vy_, px_, py_, bx, by, dxy_, dxyBs_);
+  }
+  double dxy(int i) const { return dxy_[i]; }
+  double dxyBeamSpot(int i) const { return dxyBs_[i]; }
+
+ private:
+  int n_;
+  alignas(32) double vx_[N];
+  alignas(32) double vy_[N];
+  alignas(32) double px_[N];
+  alignas(32) double py_[N];
+  alignas(32) double dxy_[N];
+  alignas(32) double dxyBs_[N];
+};
+
+#endif
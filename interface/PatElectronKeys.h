@@ -0,0 +1,100 @@
+#ifndef PatElectronKeys_H
+#define PatElectronKeys_H
+/*
+  PatElectronKeys
+  ===============
+  Electron IDs and userInts of a pat::Electron by a key resolved once,
+  instead of a search by name on every call.
+
+  ElectronIDKey keeps the position of the ID in electronIDs(); a call
+  checks that the name at that position is still the same (one string
+  compare) and searches again only when it is not, e.g. for an input
+  made with other IDs. UserIntKey does the same in userIntNames(), for
+  the check that hasUserInt makes; the value is still read by name, PAT
+  has no access to the userInts by position.
+
+    ElectronIDKey id("simpleEleId80relIso");
+    if (id.available(*ele)) value = id.value(*ele);
+
+  ElectronIDCut is the comparison of usePrecalcIDSign, parsed once:
+  "<", ">" or else |value - cut| < 0.1 (the IDs are 0..7 as floats).
+
+  Changes Log:
+  ------------
+  19.10.26: first version
+*/
+#include <cmath>
+#include <string>
+#include <vector>
+
+#include "DataFormats/PatCandidates/interface/Electron.h"
+
+class ElectronIDKey {
+ public:
+  explicit ElectronIDKey(const std::string& name = ""): name_(name), index_(-1) {}
+  const std::string& name() const { return name_; }
+
+  // the position in ele.electronIDs(), -1 if the ID is not there
+  int index(const pat::Electron& ele) const {
+    const std::vector<pat::Electron::IdPair>& ids = ele.electronIDs();
+    if (index_ >= 0 && index_ < int(ids.size()) && ids[index_].first == name_)
+      return index_;
+    index_ = -1;
+    for (unsigned int i=0; i<ids.size(); ++i)
+      if (ids[i].first == name_) { index_ = i;  break; }
+    return index_;
+  }
+  bool available(const pat::Electron& ele) const { return index(ele) >= 0; }
+  // the ID must be available
+  float value(const pat::Electron& ele) const {
+    return ele.electronIDs()[index(ele)].second;
+  }
+
+ private:
+  std::string name_;
+  mutable int index_;
+};
+
+class UserIntKey {
+ public:
+  explicit UserIntKey(const std::string& name = ""): name_(name), index_(-1) {}
+  const std::string& name() const { return name_; }
+
+  // hasUserInt
+  bool available(const pat::Electron& ele) const {
+    const std::vector<std::string>& names = ele.userIntNames();
+    if (index_ >= 0 && index_ < int(names.size()) && names[index_] == name_)
+      return true;
+    index_ = -1;
+    for (unsigned int i=0; i<names.size(); ++i)
+      if (names[i] == name_) { index_ = i;  break; }
+    return index_ >= 0;
+  }
+  int value(const pat::Electron& ele) const { return ele.userInt(name_); }
+
+ private:
+  std::string name_;
+  mutable int index_;
+};
+
+class ElectronIDCut {
+ public:
+  enum Comparison { LESS, GREATER, EQUAL };
+
+  ElectronIDCut(const std::string& sign = "=", double cut = 0.):
+    comparison_(sign == "<" ? LESS : (sign == ">" ? GREATER : EQUAL)), cut_(cut) {}
+
+  bool operator()(double value) const {
+    switch (comparison_) {
+    case LESS:    return value < cut_;
+    case GREATER: return value > cut_;
+    default:      return std::fabs(value - cut_) < 0.1;
+    }
+  }
+
+ private:
+  Comparison comparison_;
+  double cut_;
+};
+
+#endif
@@ -0,0 +1,101 @@
+#ifndef PdfAcceptance_H
+#define PdfAcceptance_H
+/*
+  PdfAcceptance
+  =============
+  Gen level acceptance of W(Z)->enu(ee) for every member of a PDF set in
+  one pass over the generator sample, instead of one pass per error
+  member. The PDF information of the event (GenEventInfoProduct: x1, x2,
+  parton ids, Q) is read once, the xf of both partons are evaluated for
+  all the members (LHAPDF6) and the weights relative to the central
+  member (PdfReweighting.h) are added to the total and accepted sums of
+  each member.
+
+  The event is counted if it has a status 1 electron with mother
+  |motherId| (24: W); it is accepted if the highest ET such electron has
+  ET > minEt and is inside the fiducial region of the skimmer:
+      |eta| < BarrelMaxEta or EndcapMinEta < |eta| < EndcapMaxEta
+
+  parameters (untracked):
+    pdfSet         LHAPDF6 set, a Hessian one (default cteq66: 45 members)
+    hessianScale   the uncertainties are divided by it (default 1; CTEQ66
+                   is 90% CL, 1.645 gives 68% CL)
+    genEventInfo   (generator)
+    MCCollection   (genParticles)
+    motherId, minEt, BarrelMaxEta, EndcapMinEta, EndcapMaxEta
+    outputfile     (pdfAcceptance.root)
+
+  The outputfile has per member (bin k+1: member k) the sums pdf_total,
+  pdf_accepted and the acceptance pdf_acceptance; the central acceptance
+  and its asymmetric Hessian uncertainty are printed at the end of the
+  job and kept in pdf_acceptance_hessian (central, +, -).
+
+  Each stream keeps its own sums, they are added at endStream, so the
+  result does not depend on the number of threads.
+
+  Changes Log:
+  ------------
+  19.10.26: first version
+*/
+// system include files
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// user include files
+#include "FWCore/Framework/interface/Frameworkfwd.h"
+#include "FWCore/Framework/interface/global/EDAnalyzer.h"
+#include "FWCore/Framework/interface/Event.h"
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "FWCore/Utilities/interface/EDGetToken.h"
+#include "FWCore/Utilities/interface/InputTag.h"
+#include "FWCore/Utilities/interface/StreamID.h"
+
+#include "DataFormats/HepMCCandidate/interface/GenParticleFwd.h"
+#include "SimDataFormats/GeneratorProducts/interface/GenEventInfoProduct.h"
+
+namespace LHAPDF { class PDF; }
+
+//
+// the sums of one stream, and its work arrays
+//
+struct PdfAcceptanceSums {
+  explicit PdfAcceptanceSums(int n):
+    events(0), skipped(0), total(n, 0.), pass(n, 0.), f1(n), f2(n), w(n) {}
+  long long events, skipped;
+  std::vector<double> total, pass;
+  std::vector<double> f1, f2, w;
+};
+
+//
+// class decleration
+//
+class PdfAcceptance : public edm::global::EDAnalyzer<edm::StreamCache<PdfAcceptanceSums> > {
+ public:
+  explicit PdfAcceptance(const edm::ParameterSet&);
+  ~PdfAcceptance();
+
+ private:
+  virtual std::unique_ptr<PdfAcceptanceSums> beginStream(edm::StreamID) const;
+  virtual void analyze(edm::StreamID, const edm::Event&, const edm::EventSetup&) const;
+  virtual void endStream(edm::StreamID) const;
+  virtual void endJob();
+
+  bool accepted(const reco::GenParticleCollection& genParticles, bool& counted) const;
+
+  std::string pdfSet_;
+  std::vector<LHAPDF::PDF*> pdfs_;
+  double hessianScale_;
+  std::string outputFile_;
+  edm::EDGetTokenT<GenEventInfoProduct> genEventInfoToken_;
+  edm::EDGetTokenT<reco::GenParticleCollection> MCToken_;
+  int motherId_;
+  double minEt_;
+  double BarrelMaxEta, EndcapMinEta, EndcapMaxEta;
+  // the sums of the job
+  mutable std::mutex mutex_;
+  mutable PdfAcceptanceSums sums_;
+};
+
+#endif
@@ -0,0 +1,77 @@
+#ifndef PdfReweighting_H
+#define PdfReweighting_H
+/*
+  PdfReweighting
+  ==============
+  The kernels of the PDF uncertainty of an acceptance, for all the members
+  of a PDF set at once (PdfAcceptance):
+
+    w_k = f_k(x1, id1, Q) f_k(x2, id2, Q) / ( f_0(x1, id1, Q) f_0(x2, id2, Q) )
+
+  is the weight of the event for member k, relative to the central member
+  0; f1[k], f2[k] are the xf of the two partons for member k. The sums of
+  w_k over all the events and over the accepted ones give the acceptance
+  A_k of every member, and with a Hessian set (central member, then pairs
+  of +/- eigenvector members, e.g. CTEQ66: 1 + 2*22) the asymmetric
+  uncertainty of A_0:
+
+    dA+ = sqrt( sum_i max(A_2i-1 - A_0, A_2i - A_0, 0)^2 )
+    dA- = sqrt( sum_i max(A_0 - A_2i-1, A_0 - A_2i, 0)^2 )
+
+  The member loops are plain arrays so that the compiler vectorizes them;
+  the xf themselves come from the PDF library, one call per member and
+  parton.
+
+  Changes Log:
+  ------------
+  19.10.26: first version
+*/
+#include <algorithm>
+#include <cmath>
+
+//
+// the weights of the n members
+//
+inline void
+pdfWeightBatch(int n, const double * __restrict__ f1,
+	       const double * __restrict__ f2, double * __restrict__ w)
+{
+  const double f0 = f1[0]*f2[0];
+  const double inv0 = f0 > 0. ? 1./f0 : 0.;
+  for (int k=0; k<n; ++k) w[k] = f1[k]*f2[k]*inv0;
+}
+
+//
+// add the event (weight: generator weight) to the sums of all the members
+//
+inline void
+pdfAccumulate(int n, const double * __restrict__ w, double weight, bool accepted,
+	      double * __restrict__ total, double * __restrict__ pass)
+{
+  const double a = accepted ? weight : 0.;
+  for (int k=0; k<n; ++k) {
+    total[k] += weight*w[k];
+    pass[k]  += a*w[k];
+  }
+}
+
+//
+// the asymmetric Hessian uncertainty of a[0] from the n members a[k],
+// (n-1)/2 pairs of eigenvector members
+//
+inline void
+hessianUncertainty(int n, const double *a, double& up, double& down)
+{
+  double up2 = 0., down2 = 0.;
+  for (int k=1; k+1<n; k+=2) {
+    const double dPlus = a[k] - a[0], dMinus = a[k+1] - a[0];
+    const double u = std::max(std::max(dPlus, dMinus), 0.);
+    const double d = std::max(std::max(-dPlus, -dMinus), 0.);
+    up2 += u*u;
+    down2 += d*d;
+  }
+  up = std::sqrt(up2);
+  down = std::sqrt(down2);
+}
+
+#endif
@@ -0,0 +1,100 @@
+#ifndef SimpleEleIdMultiProducer_H
+#define SimpleEleIdMultiProducer_H
+/*
+  SimpleEleIdMultiProducer
+  ========================
+  The simple cut based electron ID (robust, V04) of all the working points
+  in one module. It replaces the 12 clones of simpleCutBasedElectronID
+  (EleIdCutBasedExtProducer) of simpleEleIdSequence_cff, which all read
+  the same electrons and computed the same variables.
+
+  The variables of each electron are computed once (SimpleEleIdVariables)
+  and tested against the threshold table of every working point: the
+  robust<quality>EleIDCutsV04 PSets of simpleCutBasedElectronIDSpring10_cfi,
+  barrel and endcap vectors of 26 cuts:
+
+     0 H/E             7 ecal iso        14 sum iso          21 ip
+     1 sigmaIetaIeta   8 hcal iso        15 sum iso/pt       22 missing hits
+     2 |dPhiIn|        9 hcal depth1     16 ped. sum iso     23 > 0: 1st PXB hit
+     3 |dEtaIn|       10 hcal depth2     17 ped. sum iso/pt  24 conv dist
+     4 e2x5Max/e5x5   11 trk iso/pt      18 sigmaIetaIeta >  25 conv dcot
+     5 e1x5/e5x5      12 ecal iso/pt     19 E/p >
+     6 trk iso        13 hcal iso/pt     20 E/p <
+
+  with the dr03 isolations, the pedestal subtraction of the ecal isolation
+  in the barrel and the ip to the beam spot of V04. The value of each
+  working point is the one of EleIdCutBasedExtProducer: bit 1 isolation,
+  bit 0 ID, bit 2 conversion rejection (ip, missing hits, 1st layer hit,
+  dist/dcot; only if the ID passes). The conversion partner is the one of
+  the electron (convDist, convDcot), as in WenuPlots.
+
+  One ValueMap<float> per working point, keyed on the input electrons,
+  with the module label of the old clone as instance label:
+      simpleEleIds:simpleEleId95relIso ... simpleEleIds:simpleEleId60cIso
+
+  Changes Log:
+  ------------
+  19.10.26: first version
+*/
+// system include files
+#include <memory>
+#include <string>
+#include <vector>
+
+// user include files
+#include "FWCore/Framework/interface/Frameworkfwd.h"
+#include "FWCore/Framework/interface/global/EDProducer.h"
+#include "FWCore/Framework/interface/Event.h"
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "FWCore/Utilities/interface/EDGetToken.h"
+#include "FWCore/Utilities/interface/InputTag.h"
+#include "FWCore/Utilities/interface/StreamID.h"
+
+#include "DataFormats/EgammaCandidates/interface/GsfElectron.h"
+#include "DataFormats/EgammaCandidates/interface/GsfElectronFwd.h"
+#include "DataFormats/BeamSpot/interface/BeamSpot.h"
+
+//
+// what the working points are tested on, once per electron
+//
+struct SimpleEleIdVariables {
+  bool   isEB;
+  double pt;
+  double hOverE, sigmaee, deltaPhiIn, deltaEtaIn, e25Maxoe55, e15oe55, eOverP;
+  double tkIso, ecalIso, ecalIsoPed, hcalIso, hcalIso1, hcalIso2;
+  double ip, dist, dcot;
+  int    mishits;
+  bool   firstPXBHit;
+};
+
+//
+// one working point: the V04 cuts of barrel and endcap
+//
+struct SimpleEleIdWorkingPoint {
+  enum { NCUTS = 26 };
+  std::string label;
+  double cut[2][NCUTS];   // [0] barrel, [1] endcap
+  // the value of EleIdCutBasedExtProducer (robust, V04): 0..7
+  float evaluate(const SimpleEleIdVariables& v) const;
+};
+
+//
+// class decleration
+//
+class SimpleEleIdMultiProducer : public edm::global::EDProducer<> {
+ public:
+  explicit SimpleEleIdMultiProducer(const edm::ParameterSet&);
+  ~SimpleEleIdMultiProducer();
+
+  virtual void produce(edm::StreamID, edm::Event&, const edm::EventSetup&) const;
+
+  static void computeVariables(const reco::GsfElectron& ele,
+			       const reco::BeamSpot *beamSpot,
+			       SimpleEleIdVariables& v);
+ private:
+  edm::EDGetTokenT<reco::GsfElectronCollection> electronToken_;
+  edm::EDGetTokenT<reco::BeamSpot> beamSpotToken_;
+  std::vector<SimpleEleIdWorkingPoint> workingPoints_;
+};
+
+#endif
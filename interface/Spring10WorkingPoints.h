@@ -0,0 +1,273 @@
+#ifndef Spring10WorkingPoints_H
+#define Spring10WorkingPoints_H
+/*
+  Spring10WorkingPoints
+  =====================
+  Generated by scripts/makeSpring10WorkingPoints.py from
+  python/simpleCutBasedSpring10SelectionBlocks_cfi.py: do not edit, run the script again.
+
+  One type per selection block for WenuFixedSelector, with the cuts
+  in the CutVars_ order of WenuPlots (EB, EE), the preselection of the
+  block and cuts() for the runtime WenuSelector; spring10Selection
+  finds the fixed selector of a block by name ("80relIso"),
+  spring10Cuts its cuts.
+*/
+#include <string>
+#include <vector>
+
+#include "ElectroWeakAnalysis/WENu/interface/WenuFixedSelector.h"
+
+namespace spring10 {
+  // trackIso, ecalIso, hcalIso, sihih, dphi, deta, hoe, cIso, tip_bspot, eop, trackIsoUser, ecalIsoUser, hcalIsoUser
+  constexpr double wp95relIso[2*WenuSelectorVars::NVARS] = {
+    0.15, 2, 0.12, 0.01, 0.8, 0.007, 0.15, 10000, 1000, 1000, 1000, 1000, 1000,
+    0.08, 0.06, 0.05, 0.03, 0.7, 0.01, 0.07, 10000, 1000, 1000, 1000, 1000, 1000};
+  constexpr double wp95cIso[2*WenuSelectorVars::NVARS] = {
+    100000, 100000, 100000, 0.01, 0.8, 0.007, 0.15, 0.15, 1000, 1000, 1000, 1000, 1000,
+    100000, 100000, 100000, 0.03, 0.7, 0.01, 0.07, 0.1, 1000, 1000, 1000, 1000, 1000};
+  constexpr double wp90relIso[2*WenuSelectorVars::NVARS] = {
+    0.12, 0.09, 0.1, 0.01, 0.8, 0.007, 0.12, 10000, 1000, 1000, 1000, 1000, 1000,
+    0.05, 0.06, 0.03, 0.03, 0.7, 0.009, 0.05, 10000, 1000, 1000, 1000, 1000, 1000};
+  constexpr double wp90cIso[2*WenuSelectorVars::NVARS] = {
+    100000, 100000, 100000, 0.01, 0.8, 0.007, 0.12, 0.1, 1000, 1000, 1000, 1000, 1000,
+    100000, 100000, 100000, 0.03, 0.7, 0.009, 0.05, 0.07, 1000, 1000, 1000, 1000, 1000};
+  constexpr double wp85relIso[2*WenuSelectorVars::NVARS] = {
+    0.09, 0.08, 0.1, 0.01, 0.06, 0.006, 0.04, 10000, 1000, 1000, 1000, 1000, 1000,
+    0.05, 0.05, 0.025, 0.03, 0.04, 0.007, 0.025, 10000, 1000, 1000, 1000, 1000, 1000};
+  constexpr double wp85cIso[2*WenuSelectorVars::NVARS] = {
+    100000, 100000, 100000, 0.01, 0.06, 0.006, 0.04, 0.09, 1000, 1000, 1000, 1000, 1000,
+    100000, 100000, 100000, 0.03, 0.04, 0.007, 0.025, 0.06, 1000, 1000, 1000, 1000, 1000};
+  constexpr double wp80relIso[2*WenuSelectorVars::NVARS] = {
+    0.09, 0.07, 0.1, 0.01, 0.06, 0.004, 0.04, 100000, 1000, 1000, 1000, 1000, 1000,
+    0.04, 0.05, 0.025, 0.03, 0.03, 0.007, 0.025, 100000, 1000, 1000, 1000, 1000, 1000};
+  constexpr double wp80cIso[2*WenuSelectorVars::NVARS] = {
+    100000, 100000, 100000, 0.01, 0.06, 0.004, 0.04, 0.07, 1000, 1000, 1000, 1000, 1000,
+    100000, 100000, 100000, 0.03, 0.03, 0.007, 0.025, 0.06, 1000, 1000, 1000, 1000, 1000};
+  constexpr double wp70relIso[2*WenuSelectorVars::NVARS] = {
+    0.05, 0.06, 0.03, 0.01, 0.03, 0.004, 0.025, 100000, 1000, 1000, 1000, 1000, 1000,
+    0.025, 0.025, 0.02, 0.03, 0.02, 0.005, 0.025, 100000, 1000, 1000, 1000, 1000, 1000};
+  constexpr double wp70cIso[2*WenuSelectorVars::NVARS] = {
+    100000, 100000, 100000, 0.01, 0.03, 0.004, 0.025, 0.04, 1000, 1000, 1000, 1000, 1000,
+    100000, 100000, 100000, 0.03, 0.02, 0.005, 0.025, 0.03, 1000, 1000, 1000, 1000, 1000};
+  constexpr double wp60relIso[2*WenuSelectorVars::NVARS] = {
+    0.04, 0.04, 0.03, 0.01, 0.025, 0.004, 0.025, 100000, 1000, 1000, 1000, 1000, 1000,
+    0.025, 0.02, 0.02, 0.03, 0.02, 0.005, 0.025, 100000, 1000, 1000, 1000, 1000, 1000};
+  constexpr double wp60cIso[2*WenuSelectorVars::NVARS] = {
+    100000, 100000, 100000, 0.01, 0.025, 0.004, 0.025, 0.03, 1000, 1000, 1000, 1000, 1000,
+    100000, 100000, 100000, 0.03, 0.02, 0.005, 0.025, 0.02, 1000, 1000, 1000, 1000, 1000};
+}
+
+struct Spring10WP95relIso {
+  static const char *name() { return "95relIso"; }
+  static constexpr double cutEB(int i) { return spring10::wp95relIso[i]; }
+  static constexpr double cutEE(int i) { return spring10::wp95relIso[i+WenuSelectorVars::NVARS]; }
+  static constexpr bool useConversionRejection = false;
+  static constexpr bool useExpectedMissingHits = true;
+  static constexpr int maxNumberOfExpectedMissingHits = 1;
+  static std::vector<double> cuts() {
+    return std::vector<double>(spring10::wp95relIso, spring10::wp95relIso + 2*WenuSelectorVars::NVARS);
+  }
+};
+
+struct Spring10WP95cIso {
+  static const char *name() { return "95cIso"; }
+  static constexpr double cutEB(int i) { return spring10::wp95cIso[i]; }
+  static constexpr double cutEE(int i) { return spring10::wp95cIso[i+WenuSelectorVars::NVARS]; }
+  static constexpr bool useConversionRejection = false;
+  static constexpr bool useExpectedMissingHits = true;
+  static constexpr int maxNumberOfExpectedMissingHits = 1;
+  static std::vector<double> cuts() {
+    return std::vector<double>(spring10::wp95cIso, spring10::wp95cIso + 2*WenuSelectorVars::NVARS);
+  }
+};
+
+struct Spring10WP90relIso {
+  static const char *name() { return "90relIso"; }
+  static constexpr double cutEB(int i) { return spring10::wp90relIso[i]; }
+  static constexpr double cutEE(int i) { return spring10::wp90relIso[i+WenuSelectorVars::NVARS]; }
+  static constexpr bool useConversionRejection = true;
+  static constexpr bool useExpectedMissingHits = true;
+  static constexpr int maxNumberOfExpectedMissingHits = 1;
+  static std::vector<double> cuts() {
+    return std::vector<double>(spring10::wp90relIso, spring10::wp90relIso + 2*WenuSelectorVars::NVARS);
+  }
+};
+
+struct Spring10WP90cIso {
+  static const char *name() { return "90cIso"; }
+  static constexpr double cutEB(int i) { return spring10::wp90cIso[i]; }
+  static constexpr double cutEE(int i) { return spring10::wp90cIso[i+WenuSelectorVars::NVARS]; }
+  static constexpr bool useConversionRejection = true;
+  static constexpr bool useExpectedMissingHits = true;
+  static constexpr int maxNumberOfExpectedMissingHits = 1;
+  static std::vector<double> cuts() {
+    return std::vector<double>(spring10::wp90cIso, spring10::wp90cIso + 2*WenuSelectorVars::NVARS);
+  }
+};
+
+struct Spring10WP85relIso {
+  static const char *name() { return "85relIso"; }
+  static constexpr double cutEB(int i) { return spring10::wp85relIso[i]; }
+  static constexpr double cutEE(int i) { return spring10::wp85relIso[i+WenuSelectorVars::NVARS]; }
+  static constexpr bool useConversionRejection = true;
+  static constexpr bool useExpectedMissingHits = true;
+  static constexpr int maxNumberOfExpectedMissingHits = 1;
+  static std::vector<double> cuts() {
+    return std::vector<double>(spring10::wp85relIso, spring10::wp85relIso + 2*WenuSelectorVars::NVARS);
+  }
+};
+
+struct Spring10WP85cIso {
+  static const char *name() { return "85cIso"; }
+  static constexpr double cutEB(int i) { return spring10::wp85cIso[i]; }
+  static constexpr double cutEE(int i) { return spring10::wp85cIso[i+WenuSelectorVars::NVARS]; }
+  static constexpr bool useConversionRejection = true;
+  static constexpr bool useExpectedMissingHits = true;
+  static constexpr int maxNumberOfExpectedMissingHits = 1;
+  static std::vector<double> cuts() {
+    return std::vector<double>(spring10::wp85cIso, spring10::wp85cIso + 2*WenuSelectorVars::NVARS);
+  }
+};
+
+struct Spring10WP80relIso {
+  static const char *name() { return "80relIso"; }
+  static constexpr double cutEB(int i) { return spring10::wp80relIso[i]; }
+  static constexpr double cutEE(int i) { return spring10::wp80relIso[i+WenuSelectorVars::NVARS]; }
+  static constexpr bool useConversionRejection = true;
+  static constexpr bool useExpectedMissingHits = true;
+  static constexpr int maxNumberOfExpectedMissingHits = 0;
+  static std::vector<double> cuts() {
+    return std::vector<double>(spring10::wp80relIso, spring10::wp80relIso + 2*WenuSelectorVars::NVARS);
+  }
+};
+
+struct Spring10WP80cIso {
+  static const char *name() { return "80cIso"; }
+  static constexpr double cutEB(int i) { return spring10::wp80cIso[i]; }
+  static constexpr double cutEE(int i) { return spring10::wp80cIso[i+WenuSelectorVars::NVARS]; }
+  static constexpr bool useConversionRejection = true;
+  static constexpr bool useExpectedMissingHits = true;
+  static constexpr int maxNumberOfExpectedMissingHits = 0;
+  static std::vector<double> cuts() {
+    return std::vector<double>(spring10::wp80cIso, spring10::wp80cIso + 2*WenuSelectorVars::NVARS);
+  }
+};
+
+struct Spring10WP70relIso {
+  static const char *name() { return "70relIso"; }
+  static constexpr double cutEB(int i) { return spring10::wp70relIso[i]; }
+  static constexpr double cutEE(int i) { return spring10::wp70relIso[i+WenuSelectorVars::NVARS]; }
+  static constexpr bool useConversionRejection = true;
+  static constexpr bool useExpectedMissingHits = true;
+  static constexpr int maxNumberOfExpectedMissingHits = 0;
+  static std::vector<double> cuts() {
+    return std::vector<double>(spring10::wp70relIso, spring10::wp70relIso + 2*WenuSelectorVars::NVARS);
+  }
+};
+
+struct Spring10WP70cIso {
+  static const char *name() { return "70cIso"; }
+  static constexpr double cutEB(int i) { return spring10::wp70cIso[i]; }
+  static constexpr double cutEE(int i) { return spring10::wp70cIso[i+WenuSelectorVars::NVARS]; }
+  static constexpr bool useConversionRejection = true;
+  static constexpr bool useExpectedMissingHits = true;
+  static constexpr int maxNumberOfExpectedMissingHits = 0;
+  static std::vector<double> cuts() {
+    return std::vector<double>(spring10::wp70cIso, spring10::wp70cIso + 2*WenuSelectorVars::NVARS);
+  }
+};
+
+struct Spring10WP60relIso {
+  static const char *name() { return "60relIso"; }
+  static constexpr double cutEB(int i) { return spring10::wp60relIso[i]; }
+  static constexpr double cutEE(int i) { return spring10::wp60relIso[i+WenuSelectorVars::NVARS]; }
+  static constexpr bool useConversionRejection = true;
+  static constexpr bool useExpectedMissingHits = true;
+  static constexpr int maxNumberOfExpectedMissingHits = 0;
+  static std::vector<double> cuts() {
+    return std::vector<double>(spring10::wp60relIso, spring10::wp60relIso + 2*WenuSelectorVars::NVARS);
+  }
+};
+
+struct Spring10WP60cIso {
+  static const char *name() { return "60cIso"; }
+  static constexpr double cutEB(int i) { return spring10::wp60cIso[i]; }
+  static constexpr double cutEE(int i) { return spring10::wp60cIso[i+WenuSelectorVars::NVARS]; }
+  static constexpr bool useConversionRejection = true;
+  static constexpr bool useExpectedMissingHits = true;
+  static constexpr int maxNumberOfExpectedMissingHits = 0;
+  static std::vector<double> cuts() {
+    return std::vector<double>(spring10::wp60cIso, spring10::wp60cIso + 2*WenuSelectorVars::NVARS);
+  }
+};
+
+// the fixed selector of the block selection_<name>, 0 if there is none
+template <class Accessor>
+typename WenuFixedSelection<Accessor>::Function
+spring10Selection(const std::string& name)
+{
+  if (name == "95relIso")
+    return &WenuFixedSelector<Spring10WP95relIso>::template passes<Accessor>;
+  if (name == "95cIso")
+    return &WenuFixedSelector<Spring10WP95cIso>::template passes<Accessor>;
+  if (name == "90relIso")
+    return &WenuFixedSelector<Spring10WP90relIso>::template passes<Accessor>;
+  if (name == "90cIso")
+    return &WenuFixedSelector<Spring10WP90cIso>::template passes<Accessor>;
+  if (name == "85relIso")
+    return &WenuFixedSelector<Spring10WP85relIso>::template passes<Accessor>;
+  if (name == "85cIso")
+    return &WenuFixedSelector<Spring10WP85cIso>::template passes<Accessor>;
+  if (name == "80relIso")
+    return &WenuFixedSelector<Spring10WP80relIso>::template passes<Accessor>;
+  if (name == "80cIso")
+    return &WenuFixedSelector<Spring10WP80cIso>::template passes<Accessor>;
+  if (name == "70relIso")
+    return &WenuFixedSelector<Spring10WP70relIso>::template passes<Accessor>;
+  if (name == "70cIso")
+    return &WenuFixedSelector<Spring10WP70cIso>::template passes<Accessor>;
+  if (name == "60relIso")
+    return &WenuFixedSelector<Spring10WP60relIso>::template passes<Accessor>;
+  if (name == "60cIso")
+    return &WenuFixedSelector<Spring10WP60cIso>::template passes<Accessor>;
+  return 0;
+}
+
+// the cuts of the block selection_<name>, empty if there is none
+inline std::vector<double> spring10Cuts(const std::string& name)
+{
+  if (name == "95relIso") return Spring10WP95relIso::cuts();
+  if (name == "95cIso") return Spring10WP95cIso::cuts();
+  if (name == "90relIso") return Spring10WP90relIso::cuts();
+  if (name == "90cIso") return Spring10WP90cIso::cuts();
+  if (name == "85relIso") return Spring10WP85relIso::cuts();
+  if (name == "85cIso") return Spring10WP85cIso::cuts();
+  if (name == "80relIso") return Spring10WP80relIso::cuts();
+  if (name == "80cIso") return Spring10WP80cIso::cuts();
+  if (name == "70relIso") return Spring10WP70relIso::cuts();
+  if (name == "70cIso") return Spring10WP70cIso::cuts();
+  if (name == "60relIso") return Spring10WP60relIso::cuts();
+  if (name == "60cIso") return Spring10WP60cIso::cuts();
+  return std::vector<double>();
+}
+
+// all the names, in the order of the blocks
+inline std::vector<std::string> spring10WorkingPoints()
+{
+  std::vector<std::string> names;
+  names.push_back("95relIso");
+  names.push_back("95cIso");
+  names.push_back("90relIso");
+  names.push_back("90cIso");
+  names.push_back("85relIso");
+  names.push_back("85cIso");
+  names.push_back("80relIso");
+  names.push_back("80cIso");
+  names.push_back("70relIso");
+  names.push_back("70cIso");
+  names.push_back("60relIso");
+  names.push_back("60cIso");
+  return names;
+}
+
+#endif
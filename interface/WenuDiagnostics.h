@@ -0,0 +1,138 @@
+#ifndef WenuDiagnostics_H
+#define WenuDiagnostics_H
+/*
+  WenuDiagnostics
+  ===============
+  Diagnostic messages of the event loop with a compile time verbosity
+  level and, per message, sampling and a rate limit, instead of
+  unconditional std::cout: a warning that fires in every event costs
+  more than the analysis at kHz rates, and says nothing new after the
+  first few times.
+
+  The verbosity is fixed at compile time:
+      WENU_DIAG_LEVEL 0: nothing, 1: warnings (default), 2: info, 3: debug
+  e.g.  scram b USER_CXXFLAGS="-DWENU_DIAG_LEVEL=3"
+  A message above the level is a constant false condition, the compiler
+  drops it together with the expressions it prints.
+
+  Each message is declared once with the sampling (print one in every)
+  and the limit (print at most limit times, 0: no limit); the occurrences
+  of the compiled in messages are counted and the end of job summary
+  gives how many were not printed:
+
+    int noCands = diag.add("no wenu candidates", 1, 10);
+    ...
+    WENU_DIAG(diag, WENU_DIAG_WARNING, noCands, "no wenu candidates in this event");
+
+  WenuDebugDump writes the full information of a chosen list of events
+  (run, event) to a separate file, one "key=value" line per event, for
+  the debugging that used to need a recompilation of the module.
+
+  Changes Log:
+  ------------
+  19.10.26: first version
+*/
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#define WENU_DIAG_WARNING 1
+#define WENU_DIAG_INFO    2
+#define WENU_DIAG_DEBUG   3
+
+#ifndef WENU_DIAG_LEVEL
+#define WENU_DIAG_LEVEL WENU_DIAG_WARNING
+#endif
+
+// print the stream expression msg for message id, if its level is
+// compiled in and the sampling and the limit let it through
+#define WENU_DIAG(diag, level, id, msg)				\
+  do {								\
+    if ((level) <= WENU_DIAG_LEVEL && (diag).accept(id))	\
+      std::cout << (diag).prefix() << msg << std::endl;		\
+  } while (0)
+
+class WenuDiagnostics {
+ public:
+  explicit WenuDiagnostics(const std::string& module): module_(module) {}
+
+  // the messages are declared before the event loop
+  int add(const std::string& name, unsigned int every, unsigned int limit) {
+    Message m;
+    m.name = name;
+    m.every = every > 0 ? every : 1;
+    m.limit = limit;
+    messages_.push_back(m);
+    seen_.emplace_back(0);
+    return messages_.size() - 1;
+  }
+  std::string prefix() const { return module_ + ": "; }
+
+  // counts the occurrence; true if this one is printed
+  bool accept(int id) {
+    const Message& m = messages_[id];
+    const unsigned long long n = seen_[id].fetch_add(1, std::memory_order_relaxed);
+    return n % m.every == 0 && (m.limit == 0 || n/m.every < m.limit);
+  }
+
+  // the messages that occurred more often than they were printed
+  void summary() const {
+    for (unsigned int id=0; id<messages_.size(); ++id) {
+      const Message& m = messages_[id];
+      const unsigned long long n = seen_[id];
+      if (n == 0) continue;
+      unsigned long long shown = (n + m.every - 1)/m.every;
+      if (m.limit > 0 && shown > m.limit) shown = m.limit;
+      if (n > shown)
+	std::cout << prefix() << "\"" << m.name << "\": " << n
+		  << " times, " << shown << " printed" << std::endl;
+    }
+  }
+
+ private:
+  struct Message {
+    std::string name;
+    unsigned int every, limit;
+  };
+  std::string module_;
+  std::vector<Message> messages_;
+  std::deque<std::atomic<unsigned long long> > seen_;
+};
+
+//
+// the events to dump and the dump file
+//
+class WenuDebugDump {
+ public:
+  // events: (run, event) pairs; no file is opened if there are none
+  WenuDebugDump(const std::vector<std::pair<unsigned int, unsigned long long> >& events,
+		const std::string& fileName):
+    events_(events), fileName_(fileName), out_(0) {
+    std::sort(events_.begin(), events_.end());
+  }
+  ~WenuDebugDump() { delete out_; }
+
+  bool active() const { return not events_.empty(); }
+  bool wants(unsigned int run, unsigned long long event) const {
+    return active() &&
+      std::binary_search(events_.begin(), events_.end(), std::make_pair(run, event));
+  }
+  // one line per dumped event
+  void write(const std::string& line) {
+    if (out_ == 0) out_ = new std::ofstream(fileName_.c_str());
+    *out_ << line << "\n";
+    out_->flush();
+  }
+
+ private:
+  std::vector<std::pair<unsigned int, unsigned long long> > events_;
+  std::string fileName_;
+  std::ofstream *out_;
+};
+
+#endif
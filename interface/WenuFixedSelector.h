@@ -0,0 +1,102 @@
+#ifndef WenuFixedSelector_H
+#define WenuFixedSelector_H
+/*
+  WenuFixedSelector
+  =================
+  The selection of WenuSelector::passesAll with the thresholds known at
+  compile time: one selector per working point, for the tables of
+  Spring10WorkingPoints.h (generated from the selection blocks).
+
+  A working point WP is a type with
+    static constexpr double cutEB(int i), cutEE(int i);   // CutVars_ order
+  A cut with both thresholds at or above WenuFixedSelectorDisabled (the
+  1000., 10000. and 100000. "no cut" of the blocks) is removed at compile
+  time, its variable is not even read. The other cuts are evaluated all,
+  combined with & and with the EB/EE threshold picked by a select, so
+  there is no branch per cut:
+
+    WenuFixedSelector<Spring10WP80relIso>::passes(accessor, ele)
+
+  with any accessor of WenuSelector (plain, tuple, pat). The runtime
+  WenuSelector with the same cuts gives the same decisions for |value|
+  below the sentinel (benchSpring10Selectors checks all the working
+  points).
+
+  Changes Log:
+  ------------
+  19.10.26: first version
+*/
+#include <cmath>
+
+#include "ElectroWeakAnalysis/WENu/interface/WenuSelector.h"
+
+// thresholds from here on mean "no cut"
+constexpr double WenuFixedSelectorDisabled = 1000.;
+
+//
+// cut I of WP: removed when disabled
+//
+template <class WP, int I,
+	  bool ENABLED = (WP::cutEB(I) < WenuFixedSelectorDisabled ||
+			  WP::cutEE(I) < WenuFixedSelectorDisabled)>
+struct WenuFixedCut {
+  template <class Accessor>
+  static bool passes(const Accessor& accessor, const typename Accessor::Electron& e,
+		     bool barrel) {
+    const double cut = barrel ? WP::cutEB(I) : WP::cutEE(I);
+    return std::fabs(accessor.value(e, I)) < cut;
+  }
+};
+
+template <class WP, int I>
+struct WenuFixedCut<WP, I, false> {
+  template <class Accessor>
+  static bool passes(const Accessor&, const typename Accessor::Electron&, bool) {
+    return true;
+  }
+};
+
+//
+// the cuts I..NVARS-1, unrolled
+//
+template <class WP, int I>
+struct WenuFixedCuts {
+  template <class Accessor>
+  static bool passes(const Accessor& accessor, const typename Accessor::Electron& e,
+		     bool barrel) {
+    return WenuFixedCut<WP, I>::passes(accessor, e, barrel)
+      & WenuFixedCuts<WP, I+1>::passes(accessor, e, barrel);
+  }
+};
+
+template <class WP>
+struct WenuFixedCuts<WP, WenuSelectorVars::NVARS> {
+  template <class Accessor>
+  static bool passes(const Accessor&, const typename Accessor::Electron&, bool) {
+    return true;
+  }
+};
+
+template <class WP>
+struct WenuFixedSelector {
+  template <class Accessor>
+  static bool passes(const Accessor& accessor, const typename Accessor::Electron& e) {
+    return WenuFixedCuts<WP, 0>::passes(accessor, e, accessor.isBarrel(e));
+  }
+  // the number of cuts that are left
+  static int enabledCuts() {
+    int n = 0;
+    for (int i=0; i<WenuSelectorVars::NVARS; ++i)
+      if (WP::cutEB(i) < WenuFixedSelectorDisabled ||
+	  WP::cutEE(i) < WenuFixedSelectorDisabled) ++n;
+    return n;
+  }
+};
+
+// a fixed selector as a function, to choose the working point at runtime
+template <class Accessor>
+struct WenuFixedSelection {
+  typedef bool (*Function)(const Accessor&, const typename Accessor::Electron&);
+};
+
+#endif
@@ -0,0 +1,149 @@
+#ifndef WenuKinematics_H
+#define WenuKinematics_H
+/*
+  WenuKinematics
+  ==============
+  Transverse energy of clusters and transverse mass of electron + MET,
+  for a batch of electrons and MET flavours at a time:
+
+    ET = E/cosh(eta)
+    MT = sqrt( 2*(ET*MET - (ETx*METx + ETy*METy)) )
+
+  The cos/sin of the phi of each electron and each MET are computed once,
+  when it is added, and kept as the x, y components (structure of arrays),
+  so that compute() gives all the electron x MET combinations in one
+  loop without trigonometric calls, that the compiler vectorizes. WenuPlots
+  used to call cos/sin of the electron phi again for each of calo, pf and
+  tc MT and once more for the MT of the histograms.
+
+  Usage:
+    WenuKinematics<2, 3> kin;
+    const int e = kin.addElectron(transverseEnergy(energy, eta), phi);
+    const int m = kin.addMet(met, metPhi);          // for each flavour
+    kin.compute();
+    kin.mt(e, m)
+
+  MT^2 is set to 0 if rounding makes it negative (collinear electron and
+  MET), instead of giving a NaN.
+
+  Header only, so that it can also be used outside of the plugin (see
+  bin/benchWenuKinematics.cpp).
+
+  Changes Log:
+  ------------
+  19.10.26: first version
+*/
+#include <cmath>
+
+//
+// ET of a cluster of energy e at pseudorapidity eta
+//
+inline double
+transverseEnergy(double energy, double eta)
+{
+  return energy/std::cosh(eta);
+}
+
+//
+// the kernels: plain arrays
+//
+// ET of n clusters
+inline void
+transverseEnergyBatch(int n, const double * __restrict__ energy,
+		      const double * __restrict__ eta, double * __restrict__ et)
+{
+  for (int i=0; i<n; ++i) et[i] = energy[i]/std::cosh(eta[i]);
+}
+
+// MT of nEle electrons (et, x, y) with nMet MET (met, x, y):
+// mt[m*stride + e], stride >= nEle
+inline void
+transverseMassBatch(int nEle, const double * __restrict__ et,
+		    const double * __restrict__ ex,
+		    const double * __restrict__ ey,
+		    int nMet, const double * __restrict__ met,
+		    const double * __restrict__ mx,
+		    const double * __restrict__ my,
+		    int stride, double * __restrict__ mt)
+{
+  for (int m=0; m<nMet; ++m) {
+    double * __restrict__ row = mt + m*stride;
+    for (int e=0; e<nEle; ++e) {
+      const double mt2 = 2.*(et[e]*met[m] - (ex[e]*mx[m] + ey[e]*my[m]));
+      row[e] = std::sqrt(mt2 > 0. ? mt2 : 0.);
+    }
+  }
+}
+
+// MT of n (electron, MET) pairs, e.g. of the entries of a tuple
+inline void
+transverseMassPairs(int n, const double * __restrict__ et,
+		    const double * __restrict__ ex,
+		    const double * __restrict__ ey,
+		    const double * __restrict__ met,
+		    const double * __restrict__ mx,
+		    const double * __restrict__ my,
+		    double * __restrict__ mt)
+{
+  for (int i=0; i<n; ++i) {
+    const double mt2 = 2.*(et[i]*met[i] - (ex[i]*mx[i] + ey[i]*my[i]));
+    mt[i] = std::sqrt(mt2 > 0. ? mt2 : 0.);
+  }
+}
+
+//
+// the SoA buffer for at most NELE electrons and NMET MET
+//
+template <int NELE, int NMET>
+class WenuKinematics {
+ public:
+  WenuKinematics(): nEle_(0), nMet_(0) {}
+  void clear() { nEle_ = 0;  nMet_ = 0; }
+  int nElectrons() const { return nEle_; }
+  int nMet() const { return nMet_; }
+  // the index of the electron, -1 if the buffer is full
+  int addElectron(double et, double phi) {
+    if (nEle_ == NELE) return -1;
+    cos_[nEle_] = std::cos(phi);  sin_[nEle_] = std::sin(phi);
+    return setElectron(et);
+  }
+  // an other ET in the direction of electron e, e.g. with an other eta
+  int addElectronAlong(int e, double et) {
+    if (nEle_ == NELE) return -1;
+    cos_[nEle_] = cos_[e];  sin_[nEle_] = sin_[e];
+    return setElectron(et);
+  }
+  // the index of the MET, -1 if the buffer is full
+  int addMet(double met, double phi) {
+    if (nMet_ == NMET) return -1;
+    met_[nMet_] = met;
+    mx_[nMet_] = met*std::cos(phi);  my_[nMet_] = met*std::sin(phi);
+    return nMet_++;
+  }
+  void compute() {
+    transverseMassBatch(nEle_, et_, ex_, ey_, nMet_, met_, mx_, my_,
+			NELE, &mt_[0][0]);
+  }
+  double et(int e) const { return et_[e]; }
+  double met(int m) const { return met_[m]; }
+  double mt(int e, int m) const { return mt_[m][e]; }
+
+ private:
+  int setElectron(double et) {
+    et_[nEle_] = et;
+    ex_[nEle_] = et*cos_[nEle_];  ey_[nEle_] = et*sin_[nEle_];
+    return nEle_++;
+  }
+  int nEle_, nMet_;
+  alignas(32) double et_[NELE];
+  alignas(32) double cos_[NELE];
+  alignas(32) double sin_[NELE];
+  alignas(32) double ex_[NELE];
+  alignas(32) double ey_[NELE];
+  alignas(32) double met_[NMET];
+  alignas(32) double mx_[NMET];
+  alignas(32) double my_[NMET];
+  alignas(32) double mt_[NMET][NELE];
+};
+
+#endif
@@ -15,6 +15,14 @@
 #include "DataFormats/PatCandidates/interface/MET.h"
 #include "DataFormats/PatCandidates/interface/CompositeCandidate.h"
 #include "DataFormats/EgammaCandidates/interface/Electron.h"
+#include "ElectroWeakAnalysis/WENu/interface/ElectronFeatures.h"
+#include "ElectroWeakAnalysis/WENu/interface/WenuSystematics.h"
+#include "ElectroWeakAnalysis/WENu/interface/CutFlowMonitor.h"
+#include "ElectroWeakAnalysis/WENu/interface/WenuDiagnostics.h"
+#include "ElectroWeakAnalysis/WENu/interface/WenuSelectorPat.h"
+#include "ElectroWeakAnalysis/WENu/interface/Spring10WorkingPoints.h"
+#include "ElectroWeakAnalysis/WENu/interface/PatElectronKeys.h"
+#include "ElectroWeakAnalysis/WENu/interface/HistogramSnapshotServer.h"
 
 //#include "DataFormats/BeamSpot/interface/BeamSpot.h"
 
@@ -49,11 +57,57 @@ class WenuPlots : public edm::EDAnalyzer {
       Bool_t CheckCutsNminusOne(const pat::Electron *ele, Int_t jj);
       Double_t ReturnCandVar(const pat::Electron *ele, Int_t i);
       Bool_t   PassPreselectionCriteria(const pat::Electron *ele);
+      const float * Features(const pat::Electron *ele);
+      void     EtScaleRange(const pat::Electron *ele, Bool_t& passFixed,
+			    Double_t& minScale, Double_t& maxScale);
+      void     DebugDump(const edm::Event& iEvent, const pat::Electron *ele);
+      void     FillSystematics(const pat::Electron *ele, Double_t scEt, Double_t scEta,
+			       Double_t scPhi, Double_t met, Double_t metPhi,
+			       Bool_t passSelection);
+      void     PublishSnapshot();
+  // cut flow and timers (CutFlowMonitor, only with WENU_CUTFLOW)
+  enum { NCUTFLOWVARS = WenuSelectorVars::NVARS };
+  enum { CF_CANDIDATES = 0, CF_PRESELECTION, CF_CUTS,
+	 CF_SELECTED = CF_CUTS + NCUTFLOWVARS, CF_INVERTED, CF_NMINUSONE };
+  enum { T_FETCH = 0, T_FEATURES, T_TUPLE, T_JETS, T_SELECTION, T_HISTOS };
+  std::unique_ptr<CutFlowMonitor> cutFlow_;
+  std::string cutFlowFile_;
+  // event loop messages (WENU_DIAG_LEVEL) and the dump of debugEvents
+  std::unique_ptr<WenuDiagnostics> diag_;
+  std::unique_ptr<WenuDebugDump> debugDump_;
+  int msgNoCands_, msgNoCaloJets_, msgNoPfJets_;
+  int msgNoConvRej_, msgNoPXB_, msgNoMissingHits_, msgIsolation_;
+  // the electron variables (ElectronFeatures) of the event
+  std::unique_ptr<ElectronFeatureReader> features_;
+  ElectronFeatureReader::Maps featureMaps_;
+  // the cut based selection on CutVars_, InvVars_ (from beginJob)
+  std::unique_ptr<WenuSelector<PatElectronAccessor> > selector_;
+  // or a compile time working point (fixedSelection), optionally checked
+  // against selector_ for every electron
+  std::string fixedSelectionName_;
+  WenuFixedSelection<PatElectronAccessor>::Function fixedSelection_;
+  Bool_t crossCheckFixedSelection_;
+  long long crossCheckElectrons_, crossCheckDifferences_;
+  int msgFixedMismatch_;
+  // snapshots of the histograms and counters every snapshotEvery events,
+  // served on localhost:snapshotPort (0: none)
+  Int_t snapshotPort_;
+  Int_t snapshotEvery_;
+  long long snapshotEvents_;
+  std::unique_ptr<HistogramSnapshotServer> snapshotServer_;
+  std::vector<TH1F*> snapshotHistos_;
   // for the extra identifications and selections
   Bool_t   usePrecalcID_;
   std::string usePrecalcIDSign_;
   std::string usePrecalcIDType_;
   Double_t usePrecalcIDValue_;
+  ElectronIDKey precalcID_;
+  ElectronIDCut precalcIDCut_;
+  // the IDs of the second electron and the userInts, resolved once
+  enum { NELE2NDIDS = 6 };
+  ElectronIDKey ele2ndIDs_[NELE2NDIDS];
+  UserIntKey passConversionRejection_, passValidFirstPXBHit_, numberOfExpectedMissingHits_;
+  UserIntKey hasSecondElectron_, failsSecondElectronCut_, triggerDecision_;
   // for extra preselection criteria:
   Bool_t useValidFirstPXBHit_;
   Bool_t useConversionRejection_;
@@ -111,6 +165,13 @@ class WenuPlots : public edm::EDAnalyzer {
   //
   TH1F *h_trackIso_eb_NmOne;
   TH1F *h_trackIso_ee_NmOne;
+  //
+  // the systematic variations and their h_met, h_mt
+  std::unique_ptr<WenuSystematics> systematics_;
+  std::vector<double> systematicsCuts_;      // the cuts of CheckCuts, EB then EE
+  std::vector<TH1F*> h_met_syst, h_mt_syst;
+  std::vector<TH1F*> h_met_EB_syst, h_mt_EB_syst;
+  std::vector<TH1F*> h_met_EE_syst, h_mt_EE_syst;
   // ***********************************
   //
   // the selection cuts
@@ -221,6 +282,9 @@ class WenuPlots : public edm::EDAnalyzer {
   Float_t ele_hltmatched_dr;
   Int_t   event_triggerDecision;
   Int_t event_datasetTag;
+  // the preselection and the cuts of the histograms (h_met), for ABCD
+  Int_t ele_passes_preselection;
+  Int_t ele_passes_cuts;
 
   TFile *WENU_VBTFpreseleFile_;
   TFile *WENU_VBTFselectionFile_;
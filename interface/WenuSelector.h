@@ -0,0 +1,187 @@
+#ifndef WenuSelector_H
+#define WenuSelector_H
+/*
+  WenuSelector
+  ============
+  The VBTF cut based selection of WenuPlots (CheckCuts, CheckCutInv,
+  CheckCutsInverse, CheckCutsNminusOne) without the framework, on any
+  "electron-like" type. What an electron is comes from an accessor
+  policy:
+
+    typedef ... Electron;
+    bool   isBarrel(const Electron&) const;    // |sc eta| < 1.479
+    double value(const Electron&, int i) const; // selection variable i
+
+  with the variables in the order of CutVars_ (WenuSelectorVars). The
+  cuts and the inversion flags are given as in WenuPlots: 2*NVARS values,
+  the barrel ones then the endcap ones.
+
+    PlainElectronAccessor  : WenuPlainElectron, the variables in an array
+    VbtfTupleRowAccessor   : VbtfTupleRow, the branches of vbtfSele_tree
+                             and vbtfPresele_tree
+    PatElectronAccessor    : pat::Electron (WenuSelectorPat.h)
+
+  so that the same code selects in cmsRun, in the macros on the tuples
+  and in a benchmark (bin/benchWenuSelector.cpp), and the EDM and tuple
+  reselection can be compared event by event.
+
+  The inverted endcap cut is only inverted when the barrel one is too,
+  as in WenuPlots::CheckCutInv.
+
+  Changes Log:
+  ------------
+  19.10.26: first version, from WenuPlots
+*/
+#include <cmath>
+#include <vector>
+
+//
+// the selection variables, as CutVars_ of WenuPlots
+//
+struct WenuSelectorVars {
+  enum { TRACK_ISO = 0, ECAL_ISO, HCAL_ISO, SIHIH, DPHI, DETA, HOE, C_ISO,
+	 TIP_BSPOT, EOP, TRACK_ISO_USER, ECAL_ISO_USER, HCAL_ISO_USER, NVARS };
+  static const char *name(int i) {
+    static const char *names[NVARS] = {"trackIso", "ecalIso", "hcalIso", "sihih",
+				       "dphi", "deta", "hoe", "cIso", "tip_bspot",
+				       "eop", "trackIsoUser", "ecalIsoUser", "hcalIsoUser"};
+    return names[i];
+  }
+};
+
+template <class Accessor>
+class WenuSelector {
+ public:
+  typedef typename Accessor::Electron Electron;
+  enum { NVARS = WenuSelectorVars::NVARS };
+
+  // cuts, inverted: EB then EE, 2*NVARS each
+  WenuSelector(const std::vector<double>& cuts, const std::vector<bool>& inverted,
+	       const Accessor& accessor = Accessor()):
+    accessor_(accessor) {
+    for (int i=0; i<2*NVARS; ++i) {
+      cut_[i] = i < (int) cuts.size() ? cuts[i] : 1.e9;
+      inv_[i] = i < (int) inverted.size() ? inverted[i] : false;
+    }
+  }
+
+  Accessor& accessor() { return accessor_; }
+  const Accessor& accessor() const { return accessor_; }
+
+  double value(const Electron& e, int i) const { return accessor_.value(e, i); }
+  double cut(const Electron& e, int i) const {
+    return accessor_.isBarrel(e) ? cut_[i] : cut_[i+NVARS];
+  }
+
+  // CheckCut
+  bool passes(const Electron& e, int i) const {
+    return std::fabs(value(e, i)) < cut(e, i);
+  }
+  // CheckCutInv
+  bool passesInverted(const Electron& e, int i) const {
+    const double v = std::fabs(value(e, i));
+    if (accessor_.isBarrel(e)) return inv_[i] ? v > cut_[i] : v < cut_[i];
+    if (inv_[i+NVARS] && inv_[i]) return v > cut_[i+NVARS];
+    return v < cut_[i+NVARS];
+  }
+  // CheckCuts (cut based, not the precalculated ID)
+  bool passesAll(const Electron& e) const {
+    for (int i=0; i<NVARS; ++i) if (not passes(e, i)) return false;
+    return true;
+  }
+  // CheckCutsInverse
+  bool passesInverse(const Electron& e) const {
+    for (int i=0; i<NVARS; ++i) if (not passesInverted(e, i)) return false;
+    return true;
+  }
+  // CheckCutsNminusOne: all the cuts but skip
+  bool passesNminusOne(const Electron& e, int skip) const {
+    for (int i=0; i<NVARS; ++i) {
+      if (i == skip) continue;
+      if (not passes(e, i)) return false;
+    }
+    return true;
+  }
+  // the number of cuts passed in order, NVARS for a selected electron
+  int firstFailed(const Electron& e) const {
+    for (int i=0; i<NVARS; ++i) if (not passes(e, i)) return i;
+    return NVARS;
+  }
+
+ private:
+  Accessor accessor_;
+  double cut_[2*NVARS];
+  bool inv_[2*NVARS];
+};
+
+//
+// a plain struct: the variables already computed
+//
+struct WenuPlainElectron {
+  bool barrel;
+  double v[WenuSelectorVars::NVARS];
+};
+
+struct PlainElectronAccessor {
+  typedef WenuPlainElectron Electron;
+  bool isBarrel(const Electron& e) const { return e.barrel; }
+  double value(const Electron& e, int i) const { return e.v[i]; }
+};
+
+//
+// one entry of the WenuPlots tuples. The isolations of the tuple are
+// relative to the candidate ET; the user isolations are not stored, so
+// their cuts always pass (their default is 1000 GeV).
+//
+struct VbtfTupleRow {
+  float ele_sc_eta, ele_cand_et;
+  float ele_iso_track, ele_iso_ecal, ele_iso_hcal;
+  float ele_id_sihih, ele_id_dphi, ele_id_deta, ele_id_hoe;
+  float ele_tip_bs, ele_eop;
+
+  // tree: a TTree, vbtfSele_tree or vbtfPresele_tree
+  template <class Tree>
+  void setBranchAddresses(Tree *tree) {
+    tree->SetBranchAddress("ele_sc_eta", &ele_sc_eta);
+    tree->SetBranchAddress("ele_cand_et", &ele_cand_et);
+    tree->SetBranchAddress("ele_iso_track", &ele_iso_track);
+    tree->SetBranchAddress("ele_iso_ecal", &ele_iso_ecal);
+    tree->SetBranchAddress("ele_iso_hcal", &ele_iso_hcal);
+    tree->SetBranchAddress("ele_id_sihih", &ele_id_sihih);
+    tree->SetBranchAddress("ele_id_dphi", &ele_id_dphi);
+    tree->SetBranchAddress("ele_id_deta", &ele_id_deta);
+    tree->SetBranchAddress("ele_id_hoe", &ele_id_hoe);
+    tree->SetBranchAddress("ele_tip_bs", &ele_tip_bs);
+    tree->SetBranchAddress("ele_eop", &ele_eop);
+  }
+};
+
+struct VbtfTupleRowAccessor {
+  typedef VbtfTupleRow Electron;
+  bool isBarrel(const Electron& e) const { return std::fabs(e.ele_sc_eta) < 1.479; }
+  double value(const Electron& e, int i) const {
+    switch (i) {
+    case WenuSelectorVars::TRACK_ISO: return e.ele_iso_track;
+    case WenuSelectorVars::ECAL_ISO:  return e.ele_iso_ecal;
+    case WenuSelectorVars::HCAL_ISO:  return e.ele_iso_hcal;
+    case WenuSelectorVars::SIHIH:     return e.ele_id_sihih;
+    case WenuSelectorVars::DPHI:      return e.ele_id_dphi;
+    case WenuSelectorVars::DETA:      return e.ele_id_deta;
+    case WenuSelectorVars::HOE:       return e.ele_id_hoe;
+    case WenuSelectorVars::C_ISO: {
+      // the 1 GeV pedestal of the barrel ecal isolation, relative
+      double ecal = e.ele_iso_ecal;
+      if (isBarrel(e)) {
+	ecal -= e.ele_cand_et > 0 ? 1./e.ele_cand_et : 0.;
+	if (ecal < 0.) ecal = 0.;
+      }
+      return e.ele_iso_track + ecal + e.ele_iso_hcal;
+    }
+    case WenuSelectorVars::TIP_BSPOT: return std::fabs(e.ele_tip_bs);
+    case WenuSelectorVars::EOP:       return e.ele_eop;
+    default:                          return 0.;
+    }
+  }
+};
+
+#endif
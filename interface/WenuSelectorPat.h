@@ -0,0 +1,84 @@
+#ifndef WenuSelectorPat_H
+#define WenuSelectorPat_H
+/*
+  WenuSelectorPat
+  ===============
+  The pat::Electron accessor of WenuSelector: the variables of
+  WenuPlots::ReturnCandVar, from the ElectronFeatures of the electron
+  (ElectronFeatureProducer maps or computed), read once per electron.
+
+    WenuSelector<PatElectronAccessor> selector(cuts, inverted);
+    selector.accessor().setEvent(reader, maps);      // each event
+    selector.passesAll(ele)
+
+  Changes Log:
+  ------------
+  19.10.26: first version, from WenuPlots
+*/
+#include <algorithm>
+#include <cmath>
+
+#include "DataFormats/PatCandidates/interface/Electron.h"
+#include "ElectroWeakAnalysis/WENu/interface/ElectronFeatures.h"
+#include "ElectroWeakAnalysis/WENu/interface/WenuSelector.h"
+
+class PatElectronAccessor {
+ public:
+  typedef pat::Electron Electron;
+
+  PatElectronAccessor(): reader_(0), maps_(0), cached_(0) {}
+
+  // the maps of the event; forgets the cached electron
+  void setEvent(const ElectronFeatureReader *reader, const ElectronFeatureReader::Maps *maps) {
+    reader_ = reader;
+    maps_ = maps;
+    cached_ = 0;
+  }
+  // the ElectronFeatures of e, computed once per electron and event
+  const float *features(const Electron& e) const {
+    if (&e != cached_) {
+      reader_->get(*maps_, e, features_);
+      cached_ = &e;
+    }
+    return features_;
+  }
+
+  bool isBarrel(const Electron& e) const {
+    return std::fabs(e.superCluster()->eta()) < 1.479;
+  }
+  double value(const Electron& e, int i) const {
+    const float *f = features(e);
+    const double pt = e.p4().Pt();
+    switch (i) {
+    case WenuSelectorVars::TRACK_ISO: return f[ElectronFeatures::TRACK_ISO03]/pt;
+    case WenuSelectorVars::ECAL_ISO:  return f[ElectronFeatures::ECAL_ISO03]/pt;
+    case WenuSelectorVars::HCAL_ISO:  return f[ElectronFeatures::HCAL_ISO03]/pt;
+    case WenuSelectorVars::SIHIH:     return f[ElectronFeatures::SIHIH];
+    case WenuSelectorVars::DPHI:      return f[ElectronFeatures::DPHI_IN];
+    case WenuSelectorVars::DETA:      return f[ElectronFeatures::DETA_IN];
+    case WenuSelectorVars::HOE:       return f[ElectronFeatures::HOE];
+    case WenuSelectorVars::C_ISO:
+      // pedestal subtraction is only in barrel
+      if (e.isEB())
+	return (f[ElectronFeatures::TRACK_ISO03]
+		+ std::max(float(0.), f[ElectronFeatures::ECAL_ISO03]-1)
+		+ f[ElectronFeatures::HCAL_ISO03])/pt;
+      return (f[ElectronFeatures::TRACK_ISO03] + f[ElectronFeatures::ECAL_ISO03]
+	      + f[ElectronFeatures::HCAL_ISO03])/pt;
+    case WenuSelectorVars::TIP_BSPOT: return std::fabs(e.dB());
+    case WenuSelectorVars::EOP:       return f[ElectronFeatures::EOP];
+    case WenuSelectorVars::TRACK_ISO_USER: return e.userIsolation(pat::TrackIso);
+    case WenuSelectorVars::ECAL_ISO_USER:  return e.userIsolation(pat::EcalIso);
+    case WenuSelectorVars::HCAL_ISO_USER:  return e.userIsolation(pat::HcalIso);
+    default: return -1.;
+    }
+  }
+
+ private:
+  const ElectronFeatureReader *reader_;
+  const ElectronFeatureReader::Maps *maps_;
+  mutable const Electron *cached_;
+  mutable float features_[ElectronFeatures::NFEATURES];
+};
+
+#endif
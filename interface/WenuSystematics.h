@@ -0,0 +1,83 @@
+#ifndef WenuSystematics_H
+#define WenuSystematics_H
+/*
+  WenuSystematics
+  ===============
+  Energy scale and MET systematic variations of the W->enu candidate, all
+  evaluated in one pass over the events instead of one WenuPlots job per
+  variation. Each variation is a PSet of the untracked VPSet
+  systematicVariations of WenuPlots:
+
+    cms.PSet(name = cms.untracked.string("escaleEBup"),
+             ebScale = cms.untracked.double(1.02),     # default 1
+             eeScale = cms.untracked.double(1.),       # default 1
+             metScale = cms.untracked.double(1.),      # default 1
+             metSmearing = cms.untracked.double(0.),   # GeV, default 0
+             seed = cms.untracked.uint32(12345))       # default 12345
+
+  For an electron of transverse energy ET and a MET vector:
+    ET'  = s*ET, s = ebScale or eeScale by the SC eta
+    MET' = -s*ET - metScale*u,  u = -(MET + ET) the hadronic recoil
+           + a gaussian of sigma metSmearing in x and in y
+    MT'  from ET' and MET'
+  so that a variation with the defaults gives the nominal MET and MT.
+  The smearing of each variation has its own TRandom3, seeded with seed:
+  the same input gives the same histograms.
+
+  The selection: the relative isolations and E/p are the cuts of
+  WenuPlots that depend on the electron energy. A cut |iso/pT| < c passes
+  for the scaled electron iff s > |iso/pT|/c, a cut |E/p| < c iff
+  s < c/|E/p|, so WenuPlots gives, once per event, whether the other cuts
+  pass and the range of scales for which these pass (select()). The cuts
+  are those of the nominal selection (the fixedSelection working point if
+  there is one), so the variation with s=1 has the events of h_met. With
+  a precalculated ID the selection is the one of the nominal electron for
+  all the variations.
+
+  compute() works on the variations as arrays (one entry per variation)
+  and the MT are computed with transverseMassPairs of WenuKinematics.
+
+  Changes Log:
+  ------------
+  19.10.26: first version
+  19.10.26: the E/p cut, an upper bound of the scale
+*/
+#include <string>
+#include <vector>
+
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "TRandom3.h"
+
+class WenuSystematics {
+ public:
+  explicit WenuSystematics(const std::vector<edm::ParameterSet>& variations);
+  ~WenuSystematics();
+
+  int size() const { return names_.size(); }
+  const std::string& name(int v) const { return names_[v]; }
+
+  // the electron (ET, phi, in the barrel) and the MET of the event
+  void compute(double et, double phi, bool isEB, double met, double metPhi);
+  // the selection: passFixed for the cuts that do not depend on the
+  // electron energy, the others pass for minScale < s < maxScale
+  void select(bool passFixed, double minScale, double maxScale);
+
+  bool passes(int v) const { return pass_[v]; }
+  double et(int v) const { return et_[v]; }
+  double met(int v) const { return met_[v]; }
+  double mt(int v) const { return mt_[v]; }
+
+ private:
+  std::vector<std::string> names_;
+  // the parameters
+  std::vector<double> ebScale_, eeScale_, metScale_, metSmearing_;
+  std::vector<TRandom3*> random_;
+  // per event
+  std::vector<double> scale_;
+  std::vector<double> et_, ex_, ey_;
+  std::vector<double> met_, mx_, my_;
+  std::vector<double> mt_;
+  std::vector<char> pass_;
+};
+
+#endif
@@ -0,0 +1,255 @@
+/*
+     ABCDScan: the ABCD signal prediction on a full grid of the method
+     parameters, with its analytic gradient
+
+     CalcABCD (PlotCombiner.cc) solves for the signal S
+
+         A S^2 + B S + C = 0
+
+     where A, B, C depend on I, Fz, FzP, K, the EWK fraction f_ewk and the
+     populations Na..Nd, Ea..Ed of the ABCD regions. For any parameter p
+     the derivative follows from the same equation:
+
+         dS/dp = -(dA/dp S^2 + dB/dp S + dC/dp) / (2 A S + B)
+
+     with dA/dp, dB/dp, dC/dp written out in abcdWithGradient below, so one
+     evaluation gives S and its 5 derivatives at once.
+
+     The scan covers the 5 dimensional grid I x Fz x FzP x K x f_ewk. The
+     grid points are cut in rows along f_ewk; the row kernel has no branches
+     (the choice of the root of Trionym is done with selects), so that
+     the compiler vectorizes it. The rows are shared among threads. The
+     whole response surface goes to a TTree (one entry per grid point:
+     the parameters, S, the 5 derivatives, valid = the quadratic has a
+     real solution) for correlated systematics studies.
+
+     Usage (see abcd in PlotCombiner.cc):
+       ABCDScan scan(Na, Nb, Nc, Nd, Ea, Eb, Ec, Ed);
+       scan.setAxis(ABCDScan::I, Imin, Imax, 11); ...  (5 axes)
+       scan.run(nThreads);
+       scan.write("abcd_syst_scan.root");
+
+     19 Oct 26: first version
+     19 Oct 26: abcdCountGradient, dS/dN of the 4 regions
+*/
+#ifndef ABCDScan_H
+#define ABCDScan_H
+
+#include <cmath>
+#include <iostream>
+#include <vector>
+#include "TString.h"
+#include "TFile.h"
+#include "TTree.h"
+#if !defined(__CINT__) && !defined(__MAKECINT__)
+#include <thread>
+#define ABCDSCAN_THREADS
+#endif
+
+//
+// S of CalcABCD and dS/d(I, Fz, FzP, K, ewk) in grad; false if the
+// quadratic has no real solution (CalcABCD returns -1 then)
+inline bool abcdWithGradient(double I, double Fz, double FzP, double K, double ewk,
+			     double Na, double Nb, double Nc, double Nd,
+			     double Ea, double Eb, double Ec, double Ed,
+			     double& S, double *grad)
+{
+  const double na = Na - ewk*Ea, nb = Nb - ewk*Eb;
+  const double nc = Nc - ewk*Ec, nd = Nd - ewk*Ed;
+  const double qa = K*Fz*nc - nd;          // the I part of B
+  const double qb = K*na - FzP*nb;         // the (1-I) part of B
+  const double qc = nd*nb - K*na*nc;       // C/(I(1+Fz)(1+FzP))
+  //
+  const double A = (1.0-I)*(FzP-K*Fz);
+  const double B = I*(FzP+1.0)*qa + (1.0-I)*(1.0+Fz)*qb;
+  const double C = I*(1.0+Fz)*(1.0+FzP)*qc;
+  //
+  // Trionym: the root closest to Na+Nb-Ea-Eb, -C/B if A=0
+  const double sum = Na+Nb-Ea-Eb;
+  const double D2 = B*B - 4.*A*C;
+  const double D = std::sqrt(D2 > 0. ? D2 : 0.);
+  const double a2 = (A != 0.) ? 2.*A : 1.;
+  const double s1 = (-B + D)/a2;
+  const double s2 = (-B - D)/a2;
+  const double sq = std::fabs(s1-sum) < std::fabs(s2-sum) ? s1 : s2;
+  const bool valid = (A == 0.) ? (B != 0.) : (D2 > 0.);
+  S = (A == 0.) ? -C/(B != 0. ? B : 1.) : (D2 > 0. ? sq : -1.);
+  //
+  // the derivatives of A, B, C: I, Fz, FzP, K, ewk
+  const double dA[5] = { -(FzP-K*Fz), -(1.0-I)*K, (1.0-I), -(1.0-I)*Fz, 0. };
+  const double dB[5] = {
+    (FzP+1.0)*qa - (1.0+Fz)*qb,
+    I*(FzP+1.0)*K*nc + (1.0-I)*qb,
+    I*qa - (1.0-I)*(1.0+Fz)*nb,
+    I*(FzP+1.0)*Fz*nc + (1.0-I)*(1.0+Fz)*na,
+    I*(FzP+1.0)*(-K*Fz*Ec + Ed) + (1.0-I)*(1.0+Fz)*(-K*Ea + FzP*Eb) };
+  const double dC[5] = {
+    (1.0+Fz)*(1.0+FzP)*qc,
+    I*(1.0+FzP)*qc,
+    I*(1.0+Fz)*qc,
+    -I*(1.0+Fz)*(1.0+FzP)*na*nc,
+    I*(1.0+Fz)*(1.0+FzP)*(-Ed*nb - nd*Eb + K*(Ea*nc + na*Ec)) };
+  const double den = 2.*A*S + B;
+  const double inv = (valid && den != 0.) ? -1./den : 0.;
+  for (int p=0; p<5; ++p) grad[p] = (dA[p]*S*S + dB[p]*S + dC[p])*inv;
+  return valid;
+}
+
+//
+// dS/d(Na, Nb, Nc, Nd) in gradN at the solution S of abcdWithGradient
+inline void abcdCountGradient(double I, double Fz, double FzP, double K, double ewk,
+			      double Na, double Nb, double Nc, double Nd,
+			      double Ea, double Eb, double Ec, double Ed,
+			      double S, double *gradN)
+{
+  const double na = Na - ewk*Ea, nb = Nb - ewk*Eb;
+  const double nc = Nc - ewk*Ec, nd = Nd - ewk*Ed;
+  const double A = (1.0-I)*(FzP-K*Fz);
+  const double B = I*(FzP+1.0)*(K*Fz*nc - nd) + (1.0-I)*(1.0+Fz)*(K*na - FzP*nb);
+  const double c = I*(1.0+Fz)*(1.0+FzP);
+  // A does not depend on the populations
+  const double dB[4] = { (1.0-I)*(1.0+Fz)*K, -(1.0-I)*(1.0+Fz)*FzP,
+			 I*(FzP+1.0)*K*Fz, -I*(FzP+1.0) };
+  const double dC[4] = { -c*K*nc, c*nd, -c*K*na, c*nb };
+  const double den = 2.*A*S + B;
+  const double inv = den != 0. ? -1./den : 0.;
+  for (int k=0; k<4; ++k) gradN[k] = (dB[k]*S + dC[k])*inv;
+}
+
+class ABCDScan {
+ public:
+  enum Parameter { I = 0, FZ, FZP, K, EWK, NPAR };
+
+  ABCDScan(double Na, double Nb, double Nc, double Nd,
+	   double Ea, double Eb, double Ec, double Ed):
+    Na_(Na), Nb_(Nb), Nc_(Nc), Nd_(Nd), Ea_(Ea), Eb_(Eb), Ec_(Ec), Ed_(Ed)
+  {
+    for (int p=0; p<NPAR; ++p) setAxis(Parameter(p), 1., 1., 1);
+  }
+  //
+  // n equidistant points from min to max (n=1: just min)
+  void setAxis(Parameter p, double min, double max, int n)
+  {
+    axis_[p].assign(n > 0 ? n : 1, min);
+    for (int i=1; i<n; ++i) axis_[p][i] = min + (max-min)*i/(n-1);
+  }
+  int size() const
+  {
+    int n = 1;
+    for (int p=0; p<NPAR; ++p) n *= axis_[p].size();
+    return n;
+  }
+  //
+  // the whole grid; nThreads = 0: one per core
+  void run(int nThreads = 0)
+  {
+    const int n = size();
+    S_.assign(n, 0.);
+    valid_.assign(n, 0);
+    for (int p=0; p<NPAR; ++p) grad_[p].assign(n, 0.);
+    const int nRows = n/axis_[EWK].size();
+#ifdef ABCDSCAN_THREADS
+    if (nThreads <= 0) nThreads = std::thread::hardware_concurrency();
+    if (nThreads > nRows) nThreads = nRows;
+    if (nThreads > 1) {
+      std::vector<std::thread> threads;
+      for (int t=0; t<nThreads; ++t)
+	threads.push_back(std::thread(Worker(this, nRows*t/nThreads,
+					     nRows*(t+1)/nThreads)));
+      for (int t=0; t<nThreads; ++t) threads[t].join();
+      return;
+    }
+#endif
+    runRows(0, nRows);
+  }
+  //
+  // the parameter p of grid point k
+  double parameter(Parameter p, int k) const
+  {
+    // k = (((iI*nFz + iFz)*nFzP + iFzP)*nK + iK)*nEwk + iEwk
+    for (int q=NPAR-1; q>p; --q) k /= axis_[q].size();
+    return axis_[p][k % axis_[p].size()];
+  }
+  double signal(int k) const { return S_[k]; }
+  double gradient(Parameter p, int k) const { return grad_[p][k]; }
+  bool valid(int k) const { return valid_[k]; }
+  //
+  // the response surface as a TTree
+  bool write(const TString& outputFile) const
+  {
+    TFile out(outputFile, "RECREATE");
+    if (out.IsZombie()) {
+      std::cout << "ABCDScan: could not create " << outputFile << std::endl;
+      return false;
+    }
+    TTree tree("abcd_scan", "ABCD signal prediction vs method parameters");
+    double par[NPAR], S, grad[NPAR];
+    int valid;
+    const char *names[NPAR] = {"I", "Fz", "FzP", "K", "ewk"};
+    for (int p=0; p<NPAR; ++p) {
+      tree.Branch(names[p], &par[p], TString(names[p]) + "/D");
+      tree.Branch(TString("dS_d") + names[p], &grad[p],
+		  TString("dS_d") + names[p] + "/D");
+    }
+    tree.Branch("S", &S, "S/D");
+    tree.Branch("valid", &valid, "valid/I");
+    const int n = S_.size();
+    for (int k=0; k<n; ++k) {
+      for (int p=0; p<NPAR; ++p) {
+	par[p] = parameter(Parameter(p), k);
+	grad[p] = grad_[p][k];
+      }
+      S = S_[k];  valid = valid_[k];
+      tree.Fill();
+    }
+    tree.Write();
+    out.Close();
+    std::cout << "ABCDScan: " << n << " grid points in " << outputFile
+	      << std::endl;
+    return true;
+  }
+
+ private:
+  //
+  // rows [first, last): all the ewk points of a (I, Fz, FzP, K) point
+  void runRows(int first, int last)
+  {
+    const int nEwk = axis_[EWK].size();
+    const double *ewk = &axis_[EWK][0];
+    for (int row=first; row<last; ++row) {
+      const int k0 = row*nEwk;
+      const double I = parameter(ABCDScan::I, k0);
+      const double Fz = parameter(FZ, k0);
+      const double FzP = parameter(FZP, k0);
+      const double K = parameter(ABCDScan::K, k0);
+      double *S = &S_[k0];
+      double *gI = &grad_[ABCDScan::I][k0], *gFz = &grad_[FZ][k0];
+      double *gFzP = &grad_[FZP][k0], *gK = &grad_[ABCDScan::K][k0];
+      double *gEwk = &grad_[EWK][k0];
+      char *valid = &valid_[k0];
+      for (int e=0; e<nEwk; ++e) {
+	double grad[NPAR];
+	valid[e] = abcdWithGradient(I, Fz, FzP, K, ewk[e], Na_, Nb_, Nc_, Nd_,
+				    Ea_, Eb_, Ec_, Ed_, S[e], grad);
+	gI[e] = grad[0];  gFz[e] = grad[1];  gFzP[e] = grad[2];
+	gK[e] = grad[3];  gEwk[e] = grad[4];
+      }
+    }
+  }
+#ifdef ABCDSCAN_THREADS
+  struct Worker {
+    Worker(ABCDScan *s, int f, int l): scan(s), first(f), last(l) {}
+    void operator()() { scan->runRows(first, last); }
+    ABCDScan *scan;
+    int first, last;
+  };
+#endif
+
+  double Na_, Nb_, Nc_, Nd_, Ea_, Eb_, Ec_, Ed_;
+  std::vector<double> axis_[NPAR];
+  std::vector<double> S_;
+  std::vector<double> grad_[NPAR];
+  std::vector<char> valid_;
+};
+
+#endif
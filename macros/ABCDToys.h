@@ -0,0 +1,243 @@
+/*
+     ABCDToys: the distribution of the ABCD signal prediction from toys
+
+     Each toy draws the populations Na..Nd of the 4 regions from Poisson
+     distributions around the observed ones, I, Fz and FzP from Gaussians
+     of their errors (K and the EWK fraction too, if they are given an
+     error) and solves the ABCD quadratic again (abcdWithGradient of
+     ABCDScan.h, the same S as CalcABCD). The quantiles of the S of the
+     toys give the interval of S without the linear error propagation of
+     abcd, which is not good at low statistics.
+
+     The random numbers are counter based: the numbers of toy t are a
+     function of (seed, t) only, so the toys are shared among threads in
+     any way and the result is the same for any number of threads. Toys
+     without a solution of the quadratic are counted and left out.
+
+     Usage (see abcdToys in PlotCombiner.cc):
+       ABCDToys toys(Na, Nb, Nc, Nd, Ea, Eb, Ec, Ed);
+       toys.setParameter(ABCDScan::I, I, dI); ...
+       toys.run(1000000, nThreads, seed);
+       toys.quantile(0.16), toys.quantile(0.5), toys.quantile(0.84)
+       toys.write("abcd_toys.root");
+
+     19 Oct 26: first version
+*/
+#ifndef ABCDToys_H
+#define ABCDToys_H
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <vector>
+#include "TString.h"
+#include "TFile.h"
+#include "TH1D.h"
+#include "TTree.h"
+#include "ABCDScan.h"
+#if !defined(__CINT__) && !defined(__MAKECINT__)
+#include <thread>
+#define ABCDTOYS_THREADS
+#endif
+
+//
+// counter based random numbers: draw n of toy t is mix(key(seed,t) + n*G)
+class ABCDToyRandom {
+ public:
+  ABCDToyRandom(unsigned long long seed, unsigned long long toy):
+    key_(mix(mix(seed) ^ (toy + 0x9E3779B97F4A7C15ULL))), counter_(0),
+    hasSpare_(false), spare_(0) {}
+  //
+  // in (0,1)
+  double uniform()
+  {
+    const unsigned long long x = mix(key_ + (++counter_)*0x9E3779B97F4A7C15ULL);
+    return ((x >> 11) + 0.5)*(1.0/9007199254740992.0);
+  }
+  double gauss()
+  {
+    if (hasSpare_) { hasSpare_ = false;  return spare_; }
+    const double r = std::sqrt(-2.*std::log(uniform()));
+    const double phi = 2.*M_PI*uniform();
+    spare_ = r*std::sin(phi);  hasSpare_ = true;
+    return r*std::cos(phi);
+  }
+  //
+  // multiplication method for small mu, else the transformed rejection
+  // of W. Hoermann (PTRS, Insurance: Math. and Econ. 12 (1993) 39)
+  double poisson(double mu)
+  {
+    if (mu <= 0.) return 0.;
+    if (mu < 10.) {
+      const double l = std::exp(-mu);
+      double p = uniform();
+      int k = 0;
+      while (p > l) { p *= uniform();  ++k; }
+      return k;
+    }
+    const double slam = std::sqrt(mu), loglam = std::log(mu);
+    const double b = 0.931 + 2.53*slam;
+    const double a = -0.059 + 0.02483*b;
+    const double invalpha = 1.1239 + 1.1328/(b-3.4);
+    const double vr = 0.9277 - 3.6224/(b-2.);
+    while (true) {
+      const double U = uniform() - 0.5;
+      const double V = uniform();
+      const double us = 0.5 - std::fabs(U);
+      const double k = std::floor((2.*a/us + b)*U + mu + 0.43);
+      if (us >= 0.07 && V <= vr) return k;
+      if (k < 0. || (us < 0.013 && V > us)) continue;
+      if (std::log(V) + std::log(invalpha) - std::log(a/(us*us) + b) <=
+	  -mu + k*loglam - std::lgamma(k+1.)) return k;
+    }
+  }
+
+ private:
+  // the splitmix64 finalizer
+  static unsigned long long mix(unsigned long long z)
+  {
+    z = (z ^ (z >> 30))*0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27))*0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+  }
+  unsigned long long key_, counter_;
+  bool hasSpare_;
+  double spare_;
+};
+
+class ABCDToys {
+ public:
+  ABCDToys(double Na, double Nb, double Nc, double Nd,
+	   double Ea, double Eb, double Ec, double Ed)
+  {
+    N_[0] = Na;  N_[1] = Nb;  N_[2] = Nc;  N_[3] = Nd;
+    E_[0] = Ea;  E_[1] = Eb;  E_[2] = Ec;  E_[3] = Ed;
+    for (int p=0; p<ABCDScan::NPAR; ++p) setParameter(ABCDScan::Parameter(p), 1., 0.);
+  }
+  //
+  // central value and Gaussian error of a parameter (default 1 +- 0)
+  void setParameter(ABCDScan::Parameter p, double value, double error)
+  {
+    value_[p] = value;  error_[p] = error;
+  }
+  //
+  // nToys toys; nThreads = 0: one per core
+  void run(int nToys, int nThreads = 0, unsigned long long seed = 12345)
+  {
+    seed_ = seed;
+    S_.assign(nToys, 0.);
+    valid_.assign(nToys, 0);
+#ifdef ABCDTOYS_THREADS
+    if (nThreads <= 0) nThreads = std::thread::hardware_concurrency();
+    if (nThreads > nToys) nThreads = nToys;
+    if (nThreads > 1) {
+      std::vector<std::thread> threads;
+      for (int t=0; t<nThreads; ++t)
+	threads.push_back(std::thread(Worker(this, (long long) nToys*t/nThreads,
+					     (long long) nToys*(t+1)/nThreads)));
+      for (int t=0; t<nThreads; ++t) threads[t].join();
+    }
+    else
+#endif
+      runToys(0, nToys);
+    //
+    // the valid S in order, for the quantiles
+    sorted_.clear();
+    sorted_.reserve(nToys);
+    for (int t=0; t<nToys; ++t) if (valid_[t]) sorted_.push_back(S_[t]);
+    std::sort(sorted_.begin(), sorted_.end());
+  }
+  int size() const { return S_.size(); }
+  int nValid() const { return sorted_.size(); }
+  //
+  // the q quantile of S (linear interpolation), 0 if no valid toy
+  double quantile(double q) const
+  {
+    const int n = sorted_.size();
+    if (n == 0) return 0.;
+    const double x = q*(n-1);
+    const int i = std::max(0, std::min(n-1, (int) std::floor(x)));
+    const int j = std::min(n-1, i+1);
+    return sorted_[i] + (x-i)*(sorted_[j]-sorted_[i]);
+  }
+  double mean() const
+  {
+    double sum = 0.;
+    for (int i=0; i<(int) sorted_.size(); ++i) sum += sorted_[i];
+    return sorted_.empty() ? 0. : sum/sorted_.size();
+  }
+  double rms() const
+  {
+    const double m = mean();
+    double sum = 0.;
+    for (int i=0; i<(int) sorted_.size(); ++i)
+      sum += (sorted_[i]-m)*(sorted_[i]-m);
+    return sorted_.empty() ? 0. : std::sqrt(sum/sorted_.size());
+  }
+  //
+  // S of the toys: histogram h_abcd_toys and tree abcd_toys (toy, S, valid)
+  bool write(const TString& outputFile, int nBins = 200) const
+  {
+    TFile out(outputFile, "RECREATE");
+    if (out.IsZombie()) {
+      std::cout << "ABCDToys: could not create " << outputFile << std::endl;
+      return false;
+    }
+    const double lo = quantile(0.0005), hi = quantile(0.9995);
+    TH1D h("h_abcd_toys", "ABCD signal prediction of the toys;S;toys",
+	   nBins, lo, hi > lo ? hi : lo+1.);
+    for (int i=0; i<(int) sorted_.size(); ++i) h.Fill(sorted_[i]);
+    h.Write();
+    TTree tree("abcd_toys", "ABCD signal prediction of the toys");
+    int toy, valid;
+    double S;
+    tree.Branch("toy", &toy, "toy/I");
+    tree.Branch("S", &S, "S/D");
+    tree.Branch("valid", &valid, "valid/I");
+    for (toy=0; toy<(int) S_.size(); ++toy) {
+      S = S_[toy];  valid = valid_[toy];
+      tree.Fill();
+    }
+    tree.Write();
+    out.Close();
+    std::cout << "ABCDToys: " << S_.size() << " toys in " << outputFile
+	      << std::endl;
+    return true;
+  }
+
+ private:
+  void runToys(long long first, long long last)
+  {
+    const double Na = N_[0], Nb = N_[1], Nc = N_[2], Nd = N_[3];
+    for (long long t=first; t<last; ++t) {
+      ABCDToyRandom random(seed_, t);
+      const double na = random.poisson(Na), nb = random.poisson(Nb);
+      const double nc = random.poisson(Nc), nd = random.poisson(Nd);
+      double par[ABCDScan::NPAR];
+      for (int p=0; p<ABCDScan::NPAR; ++p)
+	par[p] = error_[p] > 0. ? value_[p] + error_[p]*random.gauss() : value_[p];
+      double grad[ABCDScan::NPAR];
+      valid_[t] = abcdWithGradient(par[ABCDScan::I], par[ABCDScan::FZ],
+				   par[ABCDScan::FZP], par[ABCDScan::K],
+				   par[ABCDScan::EWK], na, nb, nc, nd,
+				   E_[0], E_[1], E_[2], E_[3], S_[t], grad);
+    }
+  }
+#ifdef ABCDTOYS_THREADS
+  struct Worker {
+    Worker(ABCDToys *t, long long f, long long l): toys(t), first(f), last(l) {}
+    void operator()() { toys->runToys(first, last); }
+    ABCDToys *toys;
+    long long first, last;
+  };
+#endif
+
+  double N_[4], E_[4];
+  double value_[ABCDScan::NPAR], error_[ABCDScan::NPAR];
+  unsigned long long seed_;
+  std::vector<double> S_;
+  std::vector<char> valid_;
+  std::vector<double> sorted_;
+};
+
+#endif
@@ -0,0 +1,249 @@
+/*
+     ABCDTuples: the ABCD method directly from the WenuPlots tuples, for
+     any MET cut and MET flavour
+
+     Each input file is read once: the MET (calo, pf, tc) of the entries
+     of vbtfPresele_tree that pass the cuts (regions A and B) or the
+     inverse cuts (regions D and C) is kept with the weight of the file,
+     one table per category
+     (data/sig, qcd+bce+gje, ewk), MET flavour and selection. After
+     finish() the tables are sorted in MET and hold the prefix sums of
+     the weights and of the squared weights, so that the population of a
+     region for any MET cut is a binary search:
+
+         A, D: MET >= cut       B, C: MET < cut
+
+     as in abcd, where the cut is a low bin edge of h_met. The MET cut scan
+     (S and its statistical error for every cut, the cut of the smallest
+     relative error) needs no other pass over the tuples.
+
+     The four regions are those of h_met and h_met_inverse: all of them
+     need the preselection of WenuPlots (ele_passes_preselection), none the
+     second electron veto of vbtfSele_tree, which is not read. A and B are
+     the entries with ele_passes_cuts, the cuts of h_met (CheckCuts). The
+     inverse cuts are those of WenuPlots::CheckCutsInverse, on the
+     variables that are in the tuples: track, ecal, hcal isolation,
+     sihih, dphi, deta, H/E (no combined isolation, no user isolation), so
+     C and D may hold a few more entries than h_met_inverse.
+
+     Usage (see abcdTuples in PlotCombiner.cc):
+       ABCDTupleCuts cuts;  cuts.set(ABCDTupleCuts::DETA, 0.007, 0.01, true);
+       ABCDTuples tuples(cuts);
+       tuples.fill(file, ABCDTuples::sample(type), weight);   // each file
+       tuples.finish();
+       tuples.count(ABCDTuples::QCD, ABCDTuples::PF, ABCDTuples::SELECTED,
+                    true, 30.)
+
+     19 Oct 26: first version
+     19 Oct 26: all the regions from vbtfPresele_tree, with the preselection
+                and the cuts of h_met
+     19 Oct 26: the EB/EE gap veto compares in float
+*/
+#ifndef ABCDTuples_H
+#define ABCDTuples_H
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <utility>
+#include <vector>
+#include "TString.h"
+#include "TFile.h"
+#include "TTree.h"
+
+//
+// the inverse selection: cut[i] EB, cut[i+NVARS] EE, as the CutVars_ and
+// InvVars_ of WenuPlots
+struct ABCDTupleCuts {
+  enum { TRACKISO = 0, ECALISO, HCALISO, SIHIH, DPHI, DETA, HOE, NVARS };
+  ABCDTupleCuts()
+  {
+    for (int i=0; i<2*NVARS; ++i) { cut[i] = 1.e9;  inv[i] = false; }
+  }
+  void set(int var, double cutEB, double cutEE, bool inverted)
+  {
+    cut[var] = cutEB;  cut[var+NVARS] = cutEE;
+    inv[var] = inverted;  inv[var+NVARS] = inverted;
+  }
+  bool anyInverted() const
+  {
+    for (int i=0; i<2*NVARS; ++i) if (inv[i]) return true;
+    return false;
+  }
+  // as WenuPlots::CheckCutsInverse
+  bool passInverse(const float *var, bool barrel) const
+  {
+    for (int i=0; i<NVARS; ++i) {
+      const double v = std::fabs(var[i]);
+      if (barrel) {
+	if (inv[i] ? !(v > cut[i]) : !(v < cut[i])) return false;
+      }
+      else if (inv[i+NVARS] && inv[i]) {
+	if (!(v > cut[i+NVARS])) return false;
+      }
+      else if (!(v < cut[i+NVARS])) return false;
+    }
+    return true;
+  }
+  static const char *name(int var)
+  {
+    static const char *names[NVARS] = {"trackIso", "ecalIso", "hcalIso",
+				       "sihih", "dphi", "deta", "hoe"};
+    return names[var];
+  }
+  double cut[2*NVARS];
+  bool inv[2*NVARS];
+};
+
+class ABCDTuples {
+ public:
+  enum Sample { DATA = 0, QCD, EWK, NSAMPLES };
+  enum Flavour { CALO = 0, PF, TC, NFLAVOURS };
+  enum Selection { SELECTED = 0, INVERSE, NSELECTIONS };
+
+  explicit ABCDTuples(const ABCDTupleCuts& cuts): cuts_(cuts), finished_(false) {}
+  //
+  // the category of an input type, -1 if unknown
+  static int sample(const TString& type)
+  {
+    if (type == "sig") return DATA;
+    if (type == "qcd" || type == "bce" || type == "gje") return QCD;
+    if (type == "ewk") return EWK;
+    return -1;
+  }
+  static const char *flavourName(int f)
+  {
+    static const char *names[NFLAVOURS] = {"calo", "pf", "tc"};
+    return names[f];
+  }
+  //
+  // one pass over vbtfPresele_tree of a file; false if it is not there
+  bool fill(const TString& fileName, int sample, double weight)
+  {
+    if (sample < 0 || weight <= 0) return true;
+    TFile f(fileName);
+    if (f.IsZombie()) {
+      std::cout << "ABCDTuples: could not open " << fileName << std::endl;
+      return false;
+    }
+    const bool ok = fillTree(f, "vbtfPresele_tree", sample, weight);
+    f.Close();
+    return ok;
+  }
+  //
+  // one entry by hand
+  void add(int sample, int flavour, int selection, float met, double weight)
+  {
+    Table& t = table_[sample][flavour][selection];
+    t.entries.push_back(std::make_pair(met, weight));
+    finished_ = false;
+  }
+  //
+  // sorts the tables and makes the prefix sums
+  void finish()
+  {
+    for (int s=0; s<NSAMPLES; ++s)
+      for (int f=0; f<NFLAVOURS; ++f)
+	for (int r=0; r<NSELECTIONS; ++r) table_[s][f][r].finish();
+    finished_ = true;
+  }
+  //
+  // weighted population with MET >= cut (above) or MET < cut, and its
+  // sum of squared weights
+  double count(int sample, int flavour, int selection, bool above, double cut,
+	       double *sumw2 = 0) const
+  {
+    if (!finished_) {
+      std::cout << "ABCDTuples: count() before finish()" << std::endl;
+      return 0.;
+    }
+    const Table& t = table_[sample][flavour][selection];
+    const int k = std::lower_bound(t.met.begin(), t.met.end(), (float) cut) -
+      t.met.begin();
+    const int n = t.met.size();
+    if (sumw2) *sumw2 = above ? t.sumw2[n] - t.sumw2[k] : t.sumw2[k];
+    return above ? t.sumw[n] - t.sumw[k] : t.sumw[k];
+  }
+  int entries(int sample, int flavour, int selection) const
+  {
+    return table_[sample][flavour][selection].met.size();
+  }
+
+ private:
+  struct Table {
+    std::vector<std::pair<float, double> > entries;   // met, weight
+    std::vector<float> met;
+    std::vector<double> sumw, sumw2;                  // prefix sums, n+1
+    void finish() {
+      std::sort(entries.begin(), entries.end());
+      const int n = entries.size();
+      met.resize(n);
+      sumw.assign(n+1, 0.);
+      sumw2.assign(n+1, 0.);
+      for (int i=0; i<n; ++i) {
+	met[i] = entries[i].first;
+	const double w = entries[i].second;
+	sumw[i+1] = sumw[i] + w;
+	sumw2[i+1] = sumw2[i] + w*w;
+      }
+    }
+  };
+
+  bool fillTree(TFile& f, const char *treeName, int sample, double weight)
+  {
+    TTree *tree = (TTree*) f.Get(treeName);
+    if (tree == 0) {
+      std::cout << "ABCDTuples: no " << treeName << " in " << f.GetName()
+		<< std::endl;
+      return false;
+    }
+    const char *metNames[NFLAVOURS] = {"event_caloMET", "event_pfMET", "event_tcMET"};
+    const char *varNames[ABCDTupleCuts::NVARS] = {"ele_iso_track", "ele_iso_ecal",
+						  "ele_iso_hcal", "ele_id_sihih",
+						  "ele_id_dphi", "ele_id_deta",
+						  "ele_id_hoe"};
+    float eta, met[NFLAVOURS], var[ABCDTupleCuts::NVARS];
+    int preselected, selected;
+    // only the branches that are used are read
+    tree->SetBranchStatus("*", 0);
+    bool ok = connect(tree, "ele_sc_eta", &eta);
+    for (int m=0; m<NFLAVOURS; ++m) ok = connect(tree, metNames[m], &met[m]) && ok;
+    for (int v=0; v<ABCDTupleCuts::NVARS; ++v)
+      ok = connect(tree, varNames[v], &var[v]) && ok;
+    ok = connect(tree, "ele_passes_preselection", &preselected) && ok;
+    ok = connect(tree, "ele_passes_cuts", &selected) && ok;
+    if (!ok) return false;
+    const long long n = tree->GetEntries();
+    for (long long i=0; i<n; ++i) {
+      tree->GetEntry(i);
+      // EB and EE as the h_met_EB, h_met_EE of WenuPlots, which leave out
+      // |eta| == 1.479; the tuple has eta as a float, so the boundary is
+      // the float 1.479f (1.479 as a double is never equal to a float)
+      const float aeta = std::fabs(eta);
+      if (aeta == 1.479f || !preselected) continue;
+      if (selected)
+	for (int m=0; m<NFLAVOURS; ++m) add(sample, m, SELECTED, met[m], weight);
+      if (cuts_.passInverse(var, aeta < 1.479f))
+	for (int m=0; m<NFLAVOURS; ++m) add(sample, m, INVERSE, met[m], weight);
+    }
+    return true;
+  }
+  template <class T>
+  static bool connect(TTree *tree, const char *branch, T *address)
+  {
+    if (tree->GetBranch(branch) == 0) {
+      std::cout << "ABCDTuples: no branch " << branch << " in "
+		<< tree->GetName() << std::endl;
+      return false;
+    }
+    tree->SetBranchStatus(branch, 1);
+    tree->SetBranchAddress(branch, address);
+    return true;
+  }
+
+  ABCDTupleCuts cuts_;
+  Table table_[NSAMPLES][NFLAVOURS][NSELECTIONS];
+  bool finished_;
+};
+
+#endif
@@ -0,0 +1,599 @@
+/*
+     HistoMerger: weighted sums of the PlotCombiner input histograms,
+     per category (sig, qcd, bce, gje, ewk), with several threads
+
+     The input files (inputFiles format: file, type, weight) are cut in
+     blocks of FILES_PER_BLOCK consecutive files. The threads take the
+     blocks one after the other; each file is opened once, and each block
+     makes its own partial sums (in double precision, files in inputFiles
+     order). The partial sums are then added block after block. The order
+     of the additions does not depend on the number of threads or on which
+     thread did which block, so the result is the same bit by bit for any
+     number of threads.
+
+     Usage (see PlotCombiner.cc):
+       HistoMerger merger(file, type, weight);
+       merger.merge(names, nThreads);   // names empty: all the 1D histos
+       merger.write("combinedHistos.root");
+       merger.binning("h_met", NBins, min, max);
+       merger.add(h_qcd, "h_met", "qcd", "bce", "gje");
+
+     The output file has the merged histograms named <name>_<type>
+     (e.g. h_met_EB_qcd), all the ones that the plots and the ABCD method
+     need.
+
+     Incremental merging:
+       merger.setCache("combinedHistos.cache");   // before merge
+     keeps on disk the histograms read from every input file and the
+     partial sums of every block. An input file is read again only if its
+     size or modification time changed (setCache(file, true): if its
+     content changed) or if other histograms are asked; a block is added
+     up again only if one of its files, weights or types changed. The
+     cache keeps what the last merge of each set of histograms used. The result is the same bit by
+     bit with or without the cache.
+
+     19 Oct 26: first version, replaces HistoCache.h
+     19 Oct 26: on-disk cache of the input histograms and block sums
+*/
+#ifndef HistoMerger_H
+#define HistoMerger_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+#include "TString.h"
+#include "TROOT.h"
+#include "TSystem.h"
+#include "TH1.h"
+#include "TH1F.h"
+#include "TFile.h"
+#include "TKey.h"
+#include "TList.h"
+#if !defined(__CINT__) && !defined(__MAKECINT__)
+#include <atomic>
+#include <thread>
+#define HISTOMERGER_THREADS
+#endif
+
+class HistoMerger {
+ public:
+  enum { FILES_PER_BLOCK = 8, NTYPES = 5 };
+
+  HistoMerger(const std::vector<TString>& file, const std::vector<TString>& type,
+	      const std::vector<double>& weight):
+    file_(file), type_(file.size(), -1), weight_(weight), contentHash_(false)
+  {
+    const char *types[NTYPES] = {"sig", "qcd", "bce", "gje", "ewk"};
+    for (int i=0; i<(int) file.size(); ++i) {
+      for (int t=0; t<NTYPES; ++t) if (type[i] == types[t]) type_[i] = t;
+      if (type_[i] < 0 && weight[i] > 0)
+	std::cout << "HistoMerger: unknown type " << type[i] << " of "
+		  << file[i] << ", file ignored" << std::endl;
+    }
+  }
+  ~HistoMerger() { clear(); }
+  //
+  // the on-disk cache ("": none); contentHash: the files are compared by
+  // their content, not by size and modification time
+  void setCache(const TString& cacheFile, bool contentHash = false)
+  {
+    cacheFile_ = cacheFile;  contentHash_ = contentHash;
+  }
+  //
+  // merge the histograms names (empty: all the TH1F/TH1D of the first file)
+  // nThreads = 0: one per core. false if there is no histogram at all
+  bool merge(std::vector<TString> names, int nThreads = 0)
+  {
+    clear();
+    if (names.empty()) allHistoNames(names);
+    names_ = names;
+    namesHash_ = hash(0ULL, (int) names_.size());
+    for (int n=0; n<(int) names_.size(); ++n)
+      namesHash_ = hash(namesHash_, std::string(names_[n].Data()));
+    const int nFiles = file_.size();
+    const int nBlocks = (nFiles + FILES_PER_BLOCK - 1)/FILES_PER_BLOCK;
+    std::vector<std::vector<Partial> > blocks(nBlocks);
+    readCache();
+    newFiles_.assign(nFiles, FileEntry());
+    newBlocks_.assign(nBlocks, 0ULL);
+    filesRead_.assign(nBlocks, 0);
+    //
+    // the histograms have to survive the closing of their file
+    const bool addDirectory = TH1::AddDirectoryStatus();
+    TH1::AddDirectory(false);
+#ifdef HISTOMERGER_THREADS
+    if (nThreads <= 0) nThreads = std::thread::hardware_concurrency();
+    if (nThreads > nBlocks) nThreads = nBlocks;
+    if (nThreads > 1) {
+      ROOT::EnableThreadSafety();
+      std::atomic<int> next(0);
+      std::vector<std::thread> threads;
+      for (int t=0; t<nThreads; ++t)
+	threads.push_back(std::thread(Worker(this, &blocks, &next)));
+      for (int t=0; t<nThreads; ++t) threads[t].join();
+    }
+    else
+#endif
+      for (int b=0; b<nBlocks; ++b) mergeBlock(b, blocks[b]);
+    TH1::AddDirectory(addDirectory);
+    if (cacheFile_.Length() > 0) {
+      int read = 0;
+      for (int b=0; b<nBlocks; ++b) read += filesRead_[b];
+      std::cout << "HistoMerger: " << read << " of " << nFiles
+		<< " input files read, the others from " << cacheFile_ << std::endl;
+      writeCache(blocks);
+    }
+    //
+    // the reduction: always block 0, 1, 2, ...
+    const int nSums = names_.size()*NTYPES;
+    sums_.assign(nSums, (TH1F*) 0);
+    bool any = false;
+    for (int k=0; k<nSums; ++k) {
+      Partial total;
+      for (int b=0; b<nBlocks; ++b) total.add(blocks[b][k], names_[k/NTYPES]);
+      if (total.nBins == 0) continue;
+      TString name = names_[k/NTYPES] + "_" + typeName(k%NTYPES);
+      TH1F *h = new TH1F(name, name, total.nBins, total.min, total.max);
+      h->SetDirectory(0);
+      h->Sumw2();
+      for (int i=0; i<total.nBins+2; ++i) {
+	h->SetBinContent(i, total.content[i]);
+	h->SetBinError(i, sqrt(total.sumw2[i]));
+      }
+      sums_[k] = h;
+      any = true;
+    }
+    return any;
+  }
+  //
+  // the merged histogram of a type, 0 if no file of this type has it
+  TH1F *get(const TString& name, const TString& type) const
+  {
+    for (int n=0; n<(int) names_.size(); ++n) {
+      if (names_[n] != name) continue;
+      for (int t=0; t<NTYPES; ++t)
+	if (type == typeName(t)) return sums_[n*NTYPES+t];
+    }
+    return 0;
+  }
+  //
+  // binning of the merged histogram; false if no file has it
+  bool binning(const TString& name, int& NBins, double& min, double& max) const
+  {
+    for (int t=0; t<NTYPES; ++t) {
+      const TH1F *h = get(name, typeName(t));
+      if (h == 0) continue;
+      NBins = h->GetNbinsX();
+      min = h->GetBinLowEdge(1);
+      max = h->GetBinLowEdge(NBins+1);
+      return true;
+    }
+    return false;
+  }
+  //
+  // sum += the merged histogram of type t1 (and t2, t3)
+  void add(TH1F& sum, const TString& name,
+	   const char *t1, const char *t2 = 0, const char *t3 = 0) const
+  {
+    const char *t[3] = {t1, t2, t3};
+    for (int i=0; i<3; ++i) {
+      if (t[i] == 0) continue;
+      TH1F *h = get(name, t[i]);
+      if (h) sum.Add(h);
+    }
+  }
+  //
+  // all the merged histograms to one file
+  bool write(const TString& outputFile) const
+  {
+    TFile out(outputFile, "RECREATE");
+    if (out.IsZombie()) {
+      std::cout << "HistoMerger: could not create " << outputFile << std::endl;
+      return false;
+    }
+    out.cd();
+    for (int k=0; k<(int) sums_.size(); ++k) if (sums_[k]) sums_[k]->Write();
+    out.Close();
+    std::cout << "HistoMerger: merged histograms in " << outputFile << std::endl;
+    return true;
+  }
+
+ private:
+  //
+  // one histogram of one input file, as read (nBins = 0: not in the file)
+  struct Histo {
+    Histo(): nBins(0), min(0), max(0) {}
+    int nBins; double min, max;
+    std::vector<double> content, error;
+  };
+  //
+  // the input file as seen by the cache: key and histograms
+  struct FileEntry {
+    FileEntry(): size(-1), mtime(0), content(0), names(0) {}
+    std::string path;
+    long long size;
+    long mtime;
+    unsigned long long content, names;
+    std::vector<Histo> histos;
+    bool sameKey(const FileEntry& e, bool contentHash) const {
+      return path == e.path && size == e.size && names == e.names &&
+	(contentHash ? content == e.content : mtime == e.mtime);
+    }
+  };
+  typedef std::pair<std::string, unsigned long long> FileId;   // path, names
+  //
+  // weighted sum of one histogram of one type, in double precision
+  struct Partial {
+    Partial(): nBins(0), min(0), max(0) {}
+    int nBins; double min, max;
+    std::vector<double> content, sumw2;
+    bool book(int n, double lo, double hi, const TString& name) {
+      if (nBins == 0) {
+	nBins = n;  min = lo;  max = hi;
+	content.assign(n+2, 0.);  sumw2.assign(n+2, 0.);
+      }
+      else if (n != nBins || lo != min || hi != max) {
+	std::cout << "HistoMerger: " << name << " with a different binning,"
+		  << " ignored" << std::endl;
+	return false;
+      }
+      return true;
+    }
+    void fill(const Histo& h, double w, const TString& name) {
+      if (h.nBins == 0 || !book(h.nBins, h.min, h.max, name)) return;
+      for (int i=0; i<nBins+2; ++i) {
+	const double e = h.error[i];
+	content[i] += w*h.content[i];
+	sumw2[i] += w*w*e*e;
+      }
+    }
+    void add(const Partial& p, const TString& name) {
+      if (p.nBins == 0 || !book(p.nBins, p.min, p.max, name)) return;
+      for (int i=0; i<nBins+2; ++i) {
+	content[i] += p.content[i];  sumw2[i] += p.sumw2[i];
+      }
+    }
+  };
+  struct BlockEntry {
+    BlockEntry(): names(0) {}
+    unsigned long long names;
+    std::vector<Partial> sums;
+  };
+  //
+  // the files of block b, in order
+  void mergeBlock(int b, std::vector<Partial>& partial)
+  {
+    partial.assign(names_.size()*NTYPES, Partial());
+    const int first = b*FILES_PER_BLOCK;
+    const int last = std::min(first + (int) FILES_PER_BLOCK, (int) file_.size());
+    //
+    // the block key: names, and key, weight and type of each file
+    unsigned long long blockKey = namesHash_;
+    for (int i=first; i<last; ++i) {
+      if (weight_[i] <= 0 || type_[i] < 0) continue;
+      FileEntry& entry = newFiles_[i];
+      fileKey(file_[i], entry);
+      blockKey = hash(blockKey, entry.path);
+      blockKey = hash(blockKey, entry.size);
+      blockKey = hash(blockKey, contentHash_ ? entry.content
+		      : (unsigned long long) entry.mtime);
+      blockKey = hash(blockKey, weight_[i]);
+      blockKey = hash(blockKey, type_[i]);
+    }
+    newBlocks_[b] = blockKey;
+    //
+    // the histograms of the files: from the cache if the key is the same
+    bool allCached = true;
+    for (int i=first; i<last; ++i) {
+      if (weight_[i] <= 0 || type_[i] < 0) continue;
+      FileEntry& entry = newFiles_[i];
+      std::map<FileId, FileEntry>::const_iterator
+	cached = fileCache_.find(FileId(entry.path, namesHash_));
+      if (cached != fileCache_.end() && cached->second.sameKey(entry, contentHash_))
+	entry.histos = cached->second.histos;
+      else {
+	readFile(i, entry);
+	++filesRead_[b];
+	allCached = false;
+      }
+    }
+    std::map<unsigned long long, BlockEntry>::const_iterator
+      block = blockCache_.find(blockKey);
+    if (allCached && block != blockCache_.end()) {
+      partial = block->second.sums;
+      return;
+    }
+    for (int i=first; i<last; ++i) {
+      if (weight_[i] <= 0 || type_[i] < 0) continue;
+      for (int n=0; n<(int) names_.size(); ++n)
+	partial[n*NTYPES + type_[i]].fill(newFiles_[i].histos[n], weight_[i],
+					  names_[n]);
+    }
+  }
+  //
+  // the histograms names_ of input file i
+  void readFile(int i, FileEntry& entry) const
+  {
+    entry.histos.assign(names_.size(), Histo());
+    TFile f(file_[i]);
+    if (f.IsZombie()) {
+      std::cout << "HistoMerger: could not open " << file_[i] << std::endl;
+      entry.size = -1;   // not to be cached
+      return;
+    }
+    for (int n=0; n<(int) names_.size(); ++n) {
+      TH1 *h = (TH1*) f.Get(names_[n]);
+      if (h == 0) {
+	std::cout << "HistoMerger: no histogram " << names_[n] << " in "
+		  << file_[i] << std::endl;
+	continue;
+      }
+      Histo& histo = entry.histos[n];
+      histo.nBins = h->GetNbinsX();
+      histo.min = h->GetBinLowEdge(1);
+      histo.max = h->GetBinLowEdge(histo.nBins+1);
+      histo.content.resize(histo.nBins+2);
+      histo.error.resize(histo.nBins+2);
+      for (int k=0; k<histo.nBins+2; ++k) {
+	histo.content[k] = h->GetBinContent(k);
+	histo.error[k] = h->GetBinError(k);
+      }
+      delete h;
+    }
+    f.Close();
+  }
+#ifdef HISTOMERGER_THREADS
+  struct Worker {
+    Worker(HistoMerger *m, std::vector<std::vector<Partial> > *b,
+	   std::atomic<int> *n): merger(m), blocks(b), next(n) {}
+    void operator()() {
+      for (int b = (*next)++; b < (int) blocks->size(); b = (*next)++)
+	merger->mergeBlock(b, (*blocks)[b]);
+    }
+    HistoMerger *merger;
+    std::vector<std::vector<Partial> > *blocks;
+    std::atomic<int> *next;
+  };
+#endif
+  //
+  // the 1D histograms of the first file that is used
+  void allHistoNames(std::vector<TString>& names) const
+  {
+    for (int i=0; i<(int) file_.size(); ++i) {
+      if (weight_[i] <= 0 || type_[i] < 0) continue;
+      TFile f(file_[i]);
+      if (f.IsZombie()) continue;
+      TIter next(f.GetListOfKeys());
+      while (TKey *key = (TKey*) next()) {
+	const TString className(key->GetClassName());
+	if (className == "TH1F" || className == "TH1D")
+	  names.push_back(key->GetName());
+      }
+      return;
+    }
+  }
+  static const char *typeName(int t)
+  {
+    static const char *types[NTYPES] = {"sig", "qcd", "bce", "gje", "ewk"};
+    return types[t];
+  }
+  void clear()
+  {
+    for (int k=0; k<(int) sums_.size(); ++k) delete sums_[k];
+    sums_.clear();
+  }
+  //
+  // the cache key of a file: size, modification time, content hash
+  void fileKey(const TString& file, FileEntry& entry) const
+  {
+    entry.path = file.Data();
+    entry.names = namesHash_;
+    Long_t id, flags, mtime;
+    Long64_t size;
+    if (gSystem->GetPathInfo(file, &id, &size, &flags, &mtime) != 0) return;
+    entry.size = size;
+    entry.mtime = mtime;
+    if (!contentHash_) return;
+    std::ifstream in(file.Data(), std::ios::binary);
+    std::vector<char> buffer(1 << 16);
+    unsigned long long h = 14695981039346656037ULL;   // FNV-1a
+    while (in) {
+      in.read(&buffer[0], buffer.size());
+      const int n = in.gcount();
+      for (int k=0; k<n; ++k) {
+	h ^= (unsigned char) buffer[k];
+	h *= 1099511628211ULL;
+      }
+    }
+    entry.content = h;
+  }
+  static unsigned long long hash(unsigned long long h, unsigned long long x)
+  {
+    h ^= x + 0x9E3779B97F4A7C15ULL + (h << 6) + (h >> 2);
+    return h;
+  }
+  static unsigned long long hash(unsigned long long h, long long x)
+  {
+    return hash(h, (unsigned long long) x);
+  }
+  static unsigned long long hash(unsigned long long h, int x)
+  {
+    return hash(h, (unsigned long long) x);
+  }
+  static unsigned long long hash(unsigned long long h, double x)
+  {
+    unsigned long long bits;
+    std::memcpy(&bits, &x, sizeof(bits));
+    return hash(h, bits);
+  }
+  static unsigned long long hash(unsigned long long h, const std::string& x)
+  {
+    h = hash(h, (unsigned long long) x.size());
+    for (int k=0; k<(int) x.size(); ++k) h = hash(h, (unsigned long long) x[k]);
+    return h;
+  }
+  //
+  // the cache file: magic, version, the file entries, the block sums
+  enum { CACHE_VERSION = 1 };
+  static unsigned long long cacheMagic() { return 0x48694d6572676572ULL; }
+  template <class T> static void put(std::ostream& out, const T& x)
+  {
+    out.write((const char*) &x, sizeof(T));
+  }
+  template <class T> static bool get(std::istream& in, T& x)
+  {
+    return (bool) in.read((char*) &x, sizeof(T));
+  }
+  static void put(std::ostream& out, const std::vector<double>& v)
+  {
+    put(out, (int) v.size());
+    if (!v.empty()) out.write((const char*) &v[0], v.size()*sizeof(double));
+  }
+  static bool get(std::istream& in, std::vector<double>& v)
+  {
+    int n;
+    if (!get(in, n) || n < 0) return false;
+    v.resize(n);
+    return n == 0 || (bool) in.read((char*) &v[0], n*sizeof(double));
+  }
+  static void put(std::ostream& out, const std::string& x)
+  {
+    put(out, (int) x.size());
+    out.write(x.data(), x.size());
+  }
+  static bool get(std::istream& in, std::string& x)
+  {
+    int n;
+    if (!get(in, n) || n < 0) return false;
+    x.resize(n);
+    return n == 0 || (bool) in.read(&x[0], n);
+  }
+  void readCache()
+  {
+    fileCache_.clear();
+    blockCache_.clear();
+    if (cacheFile_.Length() == 0) return;
+    std::ifstream in(cacheFile_.Data(), std::ios::binary);
+    unsigned long long magic;
+    int version, nFiles, nBlocks;
+    if (!in || !get(in, magic) || magic != cacheMagic() ||
+	!get(in, version) || version != CACHE_VERSION) return;
+    bool ok = get(in, nFiles);
+    for (int f=0; ok && f<nFiles; ++f) {
+      FileEntry e;
+      int nHistos;
+      ok = get(in, e.path) && get(in, e.size) && get(in, e.mtime) &&
+	get(in, e.content) && get(in, e.names) && get(in, nHistos);
+      if (ok) e.histos.resize(nHistos);
+      for (int n=0; ok && n<nHistos; ++n) {
+	Histo& h = e.histos[n];
+	ok = get(in, h.nBins) && get(in, h.min) && get(in, h.max) &&
+	  get(in, h.content) && get(in, h.error);
+      }
+      if (ok) fileCache_[FileId(e.path, e.names)] = e;
+    }
+    ok = ok && get(in, nBlocks);
+    for (int b=0; ok && b<nBlocks; ++b) {
+      unsigned long long key;
+      BlockEntry e;
+      int nSums;
+      ok = get(in, key) && get(in, e.names) && get(in, nSums);
+      if (ok) e.sums.resize(nSums);
+      for (int k=0; ok && k<nSums; ++k) {
+	Partial& p = e.sums[k];
+	ok = get(in, p.nBins) && get(in, p.min) && get(in, p.max) &&
+	  get(in, p.content) && get(in, p.sumw2);
+      }
+      if (ok) blockCache_[key] = e;
+    }
+    if (!ok) {
+      std::cout << "HistoMerger: " << cacheFile_ << " is corrupted, not used"
+		<< std::endl;
+      fileCache_.clear();
+      blockCache_.clear();
+    }
+  }
+  //
+  // what this merge used, and what the last merges of other histograms
+  // used; through a temporary file, so that the cache is never half written
+  void writeCache(const std::vector<std::vector<Partial> >& blocks) const
+  {
+    const std::string tmp = std::string(cacheFile_.Data()) + ".tmp";
+    std::ofstream out(tmp.c_str(), std::ios::binary);
+    if (!out) {
+      std::cout << "HistoMerger: could not write " << tmp << std::endl;
+      return;
+    }
+    put(out, cacheMagic());
+    put(out, (int) CACHE_VERSION);
+    std::vector<const FileEntry*> files;
+    for (int i=0; i<(int) newFiles_.size(); ++i)
+      if (newFiles_[i].size >= 0) files.push_back(&newFiles_[i]);
+    for (std::map<FileId, FileEntry>::const_iterator f = fileCache_.begin();
+	 f != fileCache_.end(); ++f)
+      if (f->second.names != namesHash_) files.push_back(&f->second);
+    put(out, (int) files.size());
+    for (int i=0; i<(int) files.size(); ++i) {
+      const FileEntry& e = *files[i];
+      put(out, e.path);  put(out, e.size);  put(out, e.mtime);
+      put(out, e.content);  put(out, e.names);
+      put(out, (int) e.histos.size());
+      for (int n=0; n<(int) e.histos.size(); ++n) {
+	const Histo& h = e.histos[n];
+	put(out, h.nBins);  put(out, h.min);  put(out, h.max);
+	put(out, h.content);  put(out, h.error);
+      }
+    }
+    int nOthers = 0;
+    for (std::map<unsigned long long, BlockEntry>::const_iterator b = blockCache_.begin();
+	 b != blockCache_.end(); ++b)
+      if (b->second.names != namesHash_) ++nOthers;
+    put(out, (int) blocks.size() + nOthers);
+    for (int b=0; b<(int) blocks.size(); ++b)
+      putBlock(out, newBlocks_[b], namesHash_, blocks[b]);
+    for (std::map<unsigned long long, BlockEntry>::const_iterator b = blockCache_.begin();
+	 b != blockCache_.end(); ++b)
+      if (b->second.names != namesHash_)
+	putBlock(out, b->first, b->second.names, b->second.sums);
+    out.close();
+    if (!out || std::rename(tmp.c_str(), cacheFile_.Data()) != 0)
+      std::cout << "HistoMerger: could not write " << cacheFile_ << std::endl;
+  }
+  static void putBlock(std::ostream& out, unsigned long long key,
+		       unsigned long long names, const std::vector<Partial>& sums)
+  {
+    put(out, key);  put(out, names);
+    put(out, (int) sums.size());
+    for (int k=0; k<(int) sums.size(); ++k) {
+      const Partial& p = sums[k];
+      put(out, p.nBins);  put(out, p.min);  put(out, p.max);
+      put(out, p.content);  put(out, p.sumw2);
+    }
+  }
+
+  std::vector<TString> file_;
+  std::vector<int> type_;
+  std::vector<double> weight_;
+  std::vector<TString> names_;
+  std::vector<TH1F*> sums_;
+  // the cache: as read, and what this merge used
+  TString cacheFile_;
+  bool contentHash_;
+  unsigned long long namesHash_;
+  std::map<FileId, FileEntry> fileCache_;
+  std::map<unsigned long long, BlockEntry> blockCache_;
+  std::vector<FileEntry> newFiles_;
+  std::vector<unsigned long long> newBlocks_;
+  std::vector<int> filesRead_;
+  // not copyable: owns the histograms
+  HistoMerger(const HistoMerger&);
+  HistoMerger& operator=(const HistoMerger&);
+};
+
+#endif
@@ -42,6 +42,15 @@
      
      and you finally get the plots.
 
+     Or without ROOT interpreter: the plotCombiner executable (bin/plotCombiner.cpp,
+     built by scram together with the package) compiles this file with
+     PLOTCOMBINER_STANDALONE defined. It always draws in batch mode and exits
+     with 0 if all went well:
+     plotCombiner -i inputFiles
+     plotCombiner -i inputFiles -m wenu -t 8
+     plotCombiner -i inputFiles --METCut=30. --I=0.95 --dI=0.01 ... --mc
+     (plotCombiner -h for all the options)
+
      For the ABCD method:
      ^^^^^^^^^^^^^^^^^^^^
      you have to insert in the 2nd line instead of wenu or zee the keyword abcd(...)
@@ -62,6 +71,20 @@
            signal prediction vs the parameter variation. In order to set the limits of
            the desired variation you have to edit the values in line 113 of this code
            (they are hardwired in the code)
+           The same ranges are scanned all together on a grid of gScanPoints per
+           parameter, with the derivatives of S, in abcd_syst_scan.root (ABCDScan.h)
+     The ABCD method from the tuples (vbtfPresele_tree, with ele_passes_preselection
+     and ele_passes_cuts, the regions of h_met and h_met_inverse) instead of
+     the h_met histograms: the keyword abcdTuples(...), with the cuts of the
+     inverse selection of WenuPlots (<var>_EB, <var>_EE and the flag <var>_inv,
+     var = trackIso, ecalIso, hcalIso, sihih, dphi, deta, hoe), after the
+     parameters of the method:
+     abcdTuples(I=0.95,dI=0.01,Fz=0.6,dFz=0.01,FzP=0.56,dFzP=0.2,METCut=30.,
+                deta_EB=0.007,deta_EE=0.01,deta_inv,mc)
+     data: the sig files are the data, mc: all the files but ewk are. Each file is
+     read once, the result is given for calo, pf and tc MET, for the METCut and
+     for all the cuts of the scan (gMetScanMin, gMetScanMax, gMetScanStep), in
+     abcd_met_scan.root, with the cut of the smallest statistical error (ABCDTuples.h)
      TO DO:
      functionalities to plot more kind of plots, e.g. efficiencies
      
@@ -75,6 +98,19 @@
 	 Nikolaos Rompotis - 29 June 09
 	 18 Sept 09:  1st updgrade: input files in a text file
 	 28 May  10:  bug in IMET corrected, thanks to Sadia Khalil
+	 19 Oct  26:  each input file is opened once, the category sums are
+	              made with several threads (HistoMerger.h) and saved in
+	              combinedHistos.root
+	 19 Oct  26:  no abort(): errors are returned (runPlotCombiner), standalone
+	              executable plotCombiner
+	 19 Oct  26:  ABCD mc: systematics scan on the full parameter grid with the
+	              derivatives of S (ABCDScan.h), in abcd_syst_scan.root
+	 19 Oct  26:  ABCD: statistical error also from toys (ABCDToys.h), S
+	              distribution and quantiles in abcd_toys.root
+	 19 Oct  26:  the input histograms are cached in combinedHistos.cache: a
+	              re-run reads only the new or changed input files
+	 19 Oct  26:  abcdTuples(...): ABCD from the tuples, any MET cut and flavour,
+	              MET cut scan in abcd_met_scan.root
 	 Imperial College London
 	 
 	 
@@ -93,12 +129,27 @@
 #include "TCanvas.h"
 #include "TGraph.h"
 #include "TLegend.h"
+#include "HistoMerger.h"
+#include "ABCDScan.h"
+#include "ABCDToys.h"
+#include "ABCDTuples.h"
+#ifdef PLOTCOMBINER_STANDALONE
+#include "tdrstyle.C"
+#endif
+
+using namespace std;
+
+// return values of runPlotCombiner, plotMaker and abcd
+enum { PLOTCOMBINER_OK = 0, PLOTCOMBINER_CONFIG_ERROR = 1,
+       PLOTCOMBINER_INPUT_ERROR = 2 };
 
-void plotMaker(TString histoName, TString typeOfplot,
+int runPlotCombiner(TString inputList, TString typeOfplot);
+void loadStyle();
+int plotMaker(TString histoName, TString typeOfplot,
 	       vector<TString> file, vector<TString> type, 
 	       vector<double> weight,  TString xtitle);
 
-void abcd(vector<TString> file, vector<TString> type, vector<double> weight,
+int abcd(vector<TString> file, vector<TString> type, vector<double> weight,
 	  double METCut, double I, double dI, double Fz, double dFz, 
 	  double FzP, double dFzP, double ewkerror,
 	  double data, double mc, double mcOnly);
@@ -108,6 +159,13 @@ double CalcABCD
 (double I, double Fz, double FzP, double K, double ewk,
  double Na_, double Nb_, double Nc_, double Nd_,
  double Ea_, double Eb_, double Ec_, double Ed_);
+void abcdToys(double Na, double Nb, double Nc, double Nd,
+	      double Ea, double Eb, double Ec, double Ed,
+	      double I, double dI, double Fz, double dFz,
+	      double FzP, double dFzP, double S, double DS);
+int abcdTuples(vector<TString> file, vector<TString> type, vector<double> weight,
+	       double METCut, double I, double dI, double Fz, double dFz,
+	       double FzP, double dFzP, ABCDTupleCuts cuts, bool data);
 
 // values for systematics plots: it is fraction of the MC value
 const double EWK_SYST_MIN = 0.3;
@@ -125,15 +183,45 @@ const double FZP_SYST_MAX = 0.1;
 const double K_SYST_MIN = 0.8;
 const double K_SYST_MAX = 0.8;
 
+// the merged histograms of each category are saved here
+TString gMergedHistos = "combinedHistos.root";
+// threads for the merging of the input histograms and for the ABCD
+// systematics scan (0: one per core)
+int gMergeThreads = 0;
+// the histograms of the input files are kept here: a re-run reads only
+// the new or changed inputs ("": no cache); changed = size or modification
+// time, or (gMergeCacheContent) content
+TString gMergeCache = "combinedHistos.cache";
+bool gMergeCacheContent = false;
+// ABCD systematics scan: points per parameter on the full I, Fz, FzP, K,
+// EWK grid (0: no scan) and the file of the response surface
+int gScanPoints = 11;
+TString gScanSurface = "abcd_syst_scan.root";
+// ABCD toys for the statistical error (0: no toys), their seed and file
+int gToys = 100000;
+unsigned long long gToySeed = 12345;
+TString gToyFile = "abcd_toys.root";
+// abcdTuples: the MET cuts of the scan and its file
+double gMetScanMin = 0.;
+double gMetScanMax = 100.;
+double gMetScanStep = 1.;
+TString gMetScanFile = "abcd_met_scan.root";
 
-using namespace std;
 
 void PlotCombiner()
+{
+  runPlotCombiner("inputFiles", "");
+}
+
+//
+// reads the input list and makes the plots or the ABCD calculation
+// typeOfplot: if not empty, it is used instead of the 2nd line of the list
+int runPlotCombiner(TString inputList, TString typeOfplot)
 {
   // read the file
-  ifstream input("inputFiles");
+  ifstream input(inputList.Data());
   int i = 0;
-  TString typeOfplot = "";
+  const bool typeFromList = typeOfplot.Length() == 0;
   vector<TString> types;
   vector<TString> files;
   vector<double> weights;
@@ -147,7 +235,7 @@ void PlotCombiner()
       TString empty(' ');
       if (line[0] != c) {
 	++i;
-	if (i==1) typeOfplot=line;
+	if (i==1) { if (typeFromList) typeOfplot=line; }
 	else {
 	  // read until you find 3 words
 	  TString fname("");
@@ -183,8 +271,8 @@ void PlotCombiner()
     input.close();
   }
   else {
-    std::cout << "File with name inputFile was not found" << std::endl;
-    return;
+    std::cout << "File with name " << inputList << " was not found" << std::endl;
+    return PLOTCOMBINER_CONFIG_ERROR;
   }
 
   // now you can launch the jobs
@@ -193,14 +281,46 @@ void PlotCombiner()
     //        ====================
     // =====> WHICH HISTOS TO PLOT
     //        ====================
-    plotMaker("h_met", typeOfplot, files, types, weights, "MET (GeV)");
+    return plotMaker("h_met", typeOfplot, files, types, weights, "MET (GeV)");
   }
   else if (typeOfplot == "zee"){
     cout << "zee plot maker" << endl;
     //        ====================
     // =====> WHICH HISTOS TO PLOT
     //        ====================
-    plotMaker("h_mee", typeOfplot, files, types, weights, "M_{ee} (GeV)");
+    return plotMaker("h_mee", typeOfplot, files, types, weights, "M_{ee} (GeV)");
+  }
+  else if (typeOfplot(0,10) == "abcdTuples") {
+    double I = searchABCDstring(typeOfplot, "I");
+    double dI= searchABCDstring(typeOfplot, "dI");
+    double Fz = searchABCDstring(typeOfplot, "Fz");
+    double dFz= searchABCDstring(typeOfplot, "dFz");
+    double FzP = searchABCDstring(typeOfplot, "FzP");
+    double dFzP= searchABCDstring(typeOfplot, "dFzP");
+    double METCut =searchABCDstring(typeOfplot, "METCut");
+    double data = searchABCDstring(typeOfplot, "data");
+    double mc = searchABCDstring(typeOfplot, "mc");
+    // the inverse selection
+    ABCDTupleCuts cuts;
+    for (int v=0; v<ABCDTupleCuts::NVARS; ++v) {
+      const TString var(ABCDTupleCuts::name(v));
+      double cutEB = searchABCDstring(typeOfplot, var + "_EB");
+      double cutEE = searchABCDstring(typeOfplot, var + "_EE");
+      double inv = searchABCDstring(typeOfplot, var + "_inv");
+      cuts.set(v, cutEB < 0 ? 1.e9 : cutEB, cutEE < 0 ? 1.e9 : cutEE,
+	       inv > -0.75 && inv < 0);
+    }
+    if (METCut<0 || (data<-0.7 && mc<-0.7) || !cuts.anyInverted()) {
+      cout << "Error in your configurtion!" << endl;
+      if (METCut <0) cout << "Error in MET Cut" << endl;
+      else if (data<-0.7 && mc<-0.7)
+	cout << "You need to specify one mc or data" << endl;
+      else cout << "You need to invert one cut, e.g. deta_inv" << endl;
+      return PLOTCOMBINER_CONFIG_ERROR;
+    }
+    cout << "doing ABCD from the tuples with input: " << typeOfplot << endl;
+    return abcdTuples(files, types, weights, METCut, I, dI, Fz, dFz, FzP, dFzP,
+		      cuts, data > -0.7);
   }
   else if (typeOfplot(0,4) == "abcd") {
     // now read the parameters of the ABCD method
@@ -227,35 +347,45 @@ void PlotCombiner()
       if (METCut <0) cout << "Error in MET Cut" << endl;
       else cout << "You need to specify one mc or data or mcOnly"
 		<< endl;
-      abort();
+      return PLOTCOMBINER_CONFIG_ERROR;
     }
     if (mc>-0.7 && mc <0 && ewkerror<0) {
       cout << "You have specified mc option, but you have forgotten"
 	   << " to set the ewkerror!" << endl;
-      abort();
+      return PLOTCOMBINER_CONFIG_ERROR;
     }
     //        ===============================
     // =====> ABCD METHOD FOR BKG SUBTRACTION
     //        ===============================
     cout << "doing ABCD with input: " << typeOfplot << endl;
-    abcd(files, types, weights, METCut, I, dI, Fz, dFz, FzP, dFzP,
-	 ewkerror, data, mc, mcOnly);
+    return abcd(files, types, weights, METCut, I, dI, Fz, dFz, FzP, dFzP,
+		ewkerror, data, mc, mcOnly);
 
   }
-  // force the program to abort in order to clear the memory
-  // and avoid further use of the interpreter after
-  abort();
+  cout << "Unknown type of plot: " << typeOfplot
+       << " (wenu, zee or abcd(...) expected)" << endl;
+  return PLOTCOMBINER_CONFIG_ERROR;
+}
 
+//
+// the TDR style: compiled in the standalone version, loaded otherwise
+void loadStyle()
+{
+#ifdef PLOTCOMBINER_STANDALONE
+  setTDRStyle();
+#else
+  gROOT->Reset();
+  gROOT->ProcessLine(".L tdrstyle.C"); 
+  gROOT->ProcessLine("setTDRStyle()");
+#endif
 }
 
-void abcd( vector<TString> file, vector<TString> type, vector<double> weight, 
+int abcd( vector<TString> file, vector<TString> type, vector<double> weight, 
 	   double METCut, double I, double dI, double Fz, double dFz, 
 	   double FzP, double dFzP, double ewkerror,
 	   double data, double mc, double mcOnly)
 {
-  gROOT->Reset();
-  gROOT->ProcessLine(".L tdrstyle.C"); 
-  gROOT->ProcessLine("setTDRStyle()");
+  loadStyle();
   //
   std::cout << "Trying ABCD method for Background subtration" << std::endl;
   //
@@ -265,82 +395,46 @@ void abcd( vector<TString> file, vector<TString> type, vector<double> weight,
   TString histoName_Ea("h_met_EE");
   TString histoName_Eb("h_met_inverse_EE");
   //
+  // merge the 4 histograms of every file per category in one go
+  vector<TString> names;
+  names.push_back(histoName_Ba);  names.push_back(histoName_Bb);
+  names.push_back(histoName_Ea);  names.push_back(histoName_Eb);
+  HistoMerger merger(file, type, weight);
+  merger.setCache(gMergeCache, gMergeCacheContent);
+  merger.merge(names, gMergeThreads);
+  merger.write(gMergedHistos);
+  //
   // find one file and get the dimensions of your histogram
-  int fmax = (int) file.size();
   int NBins = 0; double min = 0; double max = -1;
-  for (int i=0; i<fmax; ++i) {
-    if (weight[i]>0) {
-      //      cout << "Loading file " << file[i] << endl;
-      TFile f(file[i]);
-      TH1F *h = (TH1F*) f.Get(histoName_Ba);
-      NBins = h->GetNbinsX();
-      min = h->GetBinLowEdge(1);
-      max = h->GetBinLowEdge(NBins+1);
-      break;
-    }
-  }
+  merger.binning(histoName_Ba, NBins, min, max);
   if (NBins ==0 || (max<min)) {
     std::cout << "PlotCombiner::abcd error: Could not find valid histograms in file"
 	      << std::endl;
-    abort();
+    return PLOTCOMBINER_INPUT_ERROR;
   }
   cout << "Histograms with "<< NBins <<" bins  and range " << min << "-" << max  << endl;
   //
   // Wenu Signal .......................................................
   TH1F h_wenu("h_wenu", "h_wenu", NBins, min, max);
   TH1F h_wenu_inv("h_wenu_inv", "h_wenu_inv", NBins, min, max);
-  for (int i=0; i<fmax; ++i) {
-    if (type[i] == "sig" && weight[i]>0 ) {
-      TFile f(file[i]);
-      //
-      TH1F *h_ba = (TH1F*) f.Get(histoName_Ba);
-      h_wenu.Add(h_ba, weight[i]);
-      TH1F *h_ea = (TH1F*) f.Get(histoName_Ea);
-      h_wenu.Add(h_ea, weight[i]);
-      //
-      TH1F *h_bb = (TH1F*) f.Get(histoName_Bb);
-      h_wenu_inv.Add(h_bb, weight[i]);
-      TH1F *h_eb = (TH1F*) f.Get(histoName_Eb);
-      h_wenu_inv.Add(h_eb, weight[i]);
-    }
-  }
+  merger.add(h_wenu, histoName_Ba, "sig");
+  merger.add(h_wenu, histoName_Ea, "sig");
+  merger.add(h_wenu_inv, histoName_Bb, "sig");
+  merger.add(h_wenu_inv, histoName_Eb, "sig");
   // QCD Bkgs
   TH1F h_qcd("h_qcd", "h_qcd", NBins, min, max);
   TH1F h_qcd_inv("h_qcd_inv", "h_qcd_inv", NBins, min, max);
-  for (int i=0; i<fmax; ++i) {
-    if ((type[i] == "qcd" || type[i] == "bce" 
-	 || type[i] == "gje") && weight[i]>0) {
-      TFile f(file[i]);
-      //
-      TH1F *h_ba = (TH1F*) f.Get(histoName_Ba);
-      h_qcd.Add(h_ba, weight[i]);
-      TH1F *h_ea = (TH1F*) f.Get(histoName_Ea);
-      h_qcd.Add(h_ea, weight[i]);
-      //
-      TH1F *h_bb = (TH1F*) f.Get(histoName_Bb);
-      h_qcd_inv.Add(h_bb, weight[i]);
-      TH1F *h_eb = (TH1F*) f.Get(histoName_Eb);
-      h_qcd_inv.Add(h_eb, weight[i]);
-    }
-  }
+  merger.add(h_qcd, histoName_Ba, "qcd", "bce", "gje");
+  merger.add(h_qcd, histoName_Ea, "qcd", "bce", "gje");
+  merger.add(h_qcd_inv, histoName_Bb, "qcd", "bce", "gje");
+  merger.add(h_qcd_inv, histoName_Eb, "qcd", "bce", "gje");
   //
   TH1F h_ewk("h_ewk", "h_ewk", NBins, min, max);
   TH1F h_ewk_inv("h_ewk_inv", "h_ewk_inv", NBins, min, max);
-  for (int i=0; i<fmax; ++i) {
-    if ( type[i] == "ewk" && weight[i]>0) {
-      TFile f(file[i]);
-      //
-      TH1F *h_ba = (TH1F*) f.Get(histoName_Ba);
-      h_ewk.Add(h_ba, weight[i]);
-      TH1F *h_ea = (TH1F*) f.Get(histoName_Ea);
-      h_ewk.Add(h_ea, weight[i]);
-      //
-      TH1F *h_bb = (TH1F*) f.Get(histoName_Bb);
-      h_ewk_inv.Add(h_bb, weight[i]);
-      TH1F *h_eb = (TH1F*) f.Get(histoName_Eb);
-      h_ewk_inv.Add(h_eb, weight[i]);
-    }
-  }
+  merger.add(h_ewk, histoName_Ba, "ewk");
+  merger.add(h_ewk, histoName_Ea, "ewk");
+  merger.add(h_ewk_inv, histoName_Bb, "ewk");
+  merger.add(h_ewk_inv, histoName_Eb, "ewk");
   //
   // calculate the METCut position
   //
@@ -383,23 +477,22 @@ void abcd( vector<TString> file, vector<TString> type, vector<double> weight,
 	      << std::endl << "No systematics available with this type of"
 	      << " calculation. If you need systematics try one of the other"
 	      << " options" << std::endl;
+    double Na = a_sig, Nb = b_sig, Nc=c_sig, Nd = d_sig;
+    double Ea = a_ewk, Eb = b_ewk, Ec=c_ewk, Ed = d_ewk;
+    //
+    // the quadratic of CalcABCD with K=1, the one that the toys solve too
     double A = (1.0-I)*(FzP-Fz);
-    double B = I*(FzP+1.0)*(FzP*(c_sig-c_ewk)-(d_sig-d_ewk)) + 
-      (1+Fz)*(1-I)*((a_sig-a_ewk)-dFzP*(b_sig-b_ewk));
-    double C = I*(1.+Fz)*(1.+FzP)*((d_sig-d_ewk)*(b_sig-b_ewk) - (a_sig-a_ewk)*(c_sig-c_ewk));
+    double B = I*(FzP+1.0)*(Fz*(Nc-Ec)-(Nd-Ed)) +
+      (1.0+Fz)*(1.0-I)*((Na-Ea)-FzP*(Nb-Eb));
+    double C = I*(1.+Fz)*(1.+FzP)*((Nd-Ed)*(Nb-Eb) - (Na-Ea)*(Nc-Ec));
     //
     // signal calculation:
-    double S = Trionym(A,B,C, a_sig+b_sig);
-
-    // the errors now:
-    // calculate the statistical error now:
+    double S = CalcABCD(I, Fz, FzP, 1., 1., Na, Nb, Nc, Nd, Ea, Eb, Ec, Ed);
+    //
     double  ApI=0, ApFz=0, ApFzP=0, ApNa=0, ApNb=0, ApNc=0, ApNd=0;
     double  BpI=0, BpFz=0, BpFzP=0, BpNa=0, BpNb=0, BpNc=0, BpNd=0;
     double  CpI=0, CpFz=0, CpFzP=0, CpNa=0, CpNb=0, CpNc=0, CpNd=0;
     double  SpI=0, SpFz=0, SpFzP=0, SpNa=0, SpNb=0, SpNc=0, SpNd=0;
-    //
-    double Na = a_sig, Nb = b_sig, Nc=c_sig, Nd = d_sig;
-    double Ea = a_ewk, Eb = b_ewk, Ec=c_ewk, Ed = d_ewk;
     if (A != 0) {
       
       ApI   = -(FzP-Fz);
@@ -499,6 +592,7 @@ void abcd( vector<TString> file, vector<TString> type, vector<double> weight,
     cout << "Total Statistical Error: " 
 	 << DS << ", (" << DS*100./S << "%)"<< endl;
     cout << "Stat Error percentages are wrt S prediction, not S mc" << endl;
+    abcdToys(Na, Nb, Nc, Nd, Ea, Eb, Ec, Ed, I, dI, Fz, dFz, FzP, dFzP, S, DS);
   }
   //
   //
@@ -509,23 +603,23 @@ void abcd( vector<TString> file, vector<TString> type, vector<double> weight,
                               // string parser
     
     //////// STATISTICAL ERROR CALCULATION /////////////////////////////
+    double Na = a_sig+a_qcd+a_ewk, Nb = b_sig+b_qcd+b_ewk;
+    double Nc=c_sig+c_qcd+c_ewk,   Nd = d_sig+d_qcd+d_ewk;
+    double Ea = a_ewk, Eb = b_ewk, Ec=c_ewk, Ed = d_ewk;
+    //
+    // the quadratic of CalcABCD with K=1, the one that the toys solve too
     double A = (1.0-I)*(FzP-Fz);
-    double B = I*(FzP+1.0)*(FzP*(c_sig+c_qcd)-(d_sig+d_qcd)) + 
-      (1+Fz)*(1-I)*((a_sig+a_qcd)-dFzP*(b_sig+b_qcd));
-    double C = I*(1.+Fz)*(1.+FzP)*((d_sig+d_qcd)*(b_sig+b_qcd) - 
-				   (a_sig+a_qcd)*(c_sig+c_qcd));
+    double B = I*(FzP+1.0)*(Fz*(Nc-Ec)-(Nd-Ed)) +
+      (1.0+Fz)*(1.0-I)*((Na-Ea)-FzP*(Nb-Eb));
+    double C = I*(1.+Fz)*(1.+FzP)*((Nd-Ed)*(Nb-Eb) - (Na-Ea)*(Nc-Ec));
     //
     // signal calculation:
-    double S = Trionym(A,B,C, a_sig+b_sig);
+    double S = CalcABCD(I, Fz, FzP, 1., 1., Na, Nb, Nc, Nd, Ea, Eb, Ec, Ed);
     //
     double  ApI=0, ApFz=0, ApFzP=0, ApNa=0, ApNb=0, ApNc=0, ApNd=0;
     double  BpI=0, BpFz=0, BpFzP=0, BpNa=0, BpNb=0, BpNc=0, BpNd=0;
     double  CpI=0, CpFz=0, CpFzP=0, CpNa=0, CpNb=0, CpNc=0, CpNd=0;
     double  SpI=0, SpFz=0, SpFzP=0, SpNa=0, SpNb=0, SpNc=0, SpNd=0;
-    //
-    double Na = a_sig+a_qcd+a_ewk, Nb = b_sig+b_qcd+b_ewk;
-    double Nc=c_sig+c_qcd+c_ewk,   Nd = d_sig+d_qcd+d_ewk;
-    double Ea = a_ewk, Eb = b_ewk, Ec=c_ewk, Ed = d_ewk;
     if (A != 0) {
       
       ApI   = -(FzP-Fz);
@@ -729,6 +823,26 @@ void abcd( vector<TString> file, vector<TString> type, vector<double> weight,
     g_k.Draw("AL");
     c.Print("k_syst_variation.C");
     //
+    // the same ranges on the full grid, all parameters varied together,
+    // with the derivatives of S: for correlated systematics studies
+    double grad[ABCDScan::NPAR];
+    double S_grad;
+    abcdWithGradient(Imc, Fzmc, FzPmc, KMC, 1., Na, Nb, Nc, Nd, Ea,Eb,Ec,Ed,
+		     S_grad, grad);
+    cout << "dS/dI=" << grad[ABCDScan::I] << ", dS/dFz=" << grad[ABCDScan::FZ]
+	 << ", dS/dFzP=" << grad[ABCDScan::FZP] << ", dS/dK=" << grad[ABCDScan::K]
+	 << ", dS/dEWK=" << grad[ABCDScan::EWK] << " at the MC values" << endl;
+    if (gScanPoints > 0) {
+      ABCDScan scan(Na, Nb, Nc, Nd, Ea, Eb, Ec, Ed);
+      scan.setAxis(ABCDScan::I, i_syst_min, Imc+i_syst_max, gScanPoints);
+      scan.setAxis(ABCDScan::FZ, fz_syst_min, Fzmc+fz_syst_max, gScanPoints);
+      scan.setAxis(ABCDScan::FZP, fzp_syst_min, FzPmc+fzp_syst_max, gScanPoints);
+      scan.setAxis(ABCDScan::K, k_syst_min, KMC+k_syst_max, gScanPoints);
+      scan.setAxis(ABCDScan::EWK, 1.-ewk_syst_min, 1.+ewk_syst_max, gScanPoints);
+      scan.run(gMergeThreads);
+      scan.write(gScanSurface);
+    }
+    //
     // ******************************************************************
     //
     //
@@ -799,6 +913,7 @@ void abcd( vector<TString> file, vector<TString> type, vector<double> weight,
     cout << "Total Statistical Error: " 
 	 << DS << ", (" << DS*100./S << "%)"<< endl;
     cout << "Stat Error percentages are wrt S prediction, not S mc" << endl;
+    abcdToys(Na, Nb, Nc, Nd, Ea, Eb, Ec, Ed, I, dI, Fz, dFz, FzP, dFzP, S, DS);
     cout << endl;
     cout << "Systematic Error Summary:" << endl;
     cout << "due to k   = " << err_k << " ( " << err_k*100./S  << "%)" << endl;
@@ -836,25 +951,23 @@ void abcd( vector<TString> file, vector<TString> type, vector<double> weight,
     double KMC = (d_qcd/c_qcd)/(a_qcd/b_qcd);
     //
     // now everything is done from data + input
+    double Na = a_sig+a_qcd+a_ewk, Nb = b_sig+b_qcd+b_ewk;
+    double Nc=c_sig+c_qcd+c_ewk,   Nd = d_sig+d_qcd+d_ewk;
+    double Ea = a_ewk, Eb = b_ewk, Ec=c_ewk, Ed = d_ewk;
+    //
+    // the quadratic of CalcABCD with K=1, the one that the toys solve too
     double A = (1.0-I)*(FzP-Fz);
-    double B = I*(FzP+1.0)*(FzP*(c_sig+c_qcd)-(d_sig+d_qcd)) + 
-      (1+Fz)*(1-I)*((a_sig+a_qcd)-dFzP*(b_sig+b_qcd));
-    double C = I*(1.+Fz)*(1.+FzP)*((d_sig+d_qcd)*(b_sig+b_qcd) - 
-				   (a_sig+a_qcd)*(c_sig+c_qcd));
+    double B = I*(FzP+1.0)*(Fz*(Nc-Ec)-(Nd-Ed)) +
+      (1.0+Fz)*(1.0-I)*((Na-Ea)-FzP*(Nb-Eb));
+    double C = I*(1.+Fz)*(1.+FzP)*((Nd-Ed)*(Nb-Eb) - (Na-Ea)*(Nc-Ec));
     //
     // signal calculation:
-    double S = Trionym(A,B,C, a_sig+b_sig);
-
-    // the errors now:
-    // calculate the statistical error now:
+    double S = CalcABCD(I, Fz, FzP, 1., 1., Na, Nb, Nc, Nd, Ea, Eb, Ec, Ed);
+    //
     double  ApI=0, ApFz=0, ApFzP=0, ApNa=0, ApNb=0, ApNc=0, ApNd=0;
     double  BpI=0, BpFz=0, BpFzP=0, BpNa=0, BpNb=0, BpNc=0, BpNd=0;
     double  CpI=0, CpFz=0, CpFzP=0, CpNa=0, CpNb=0, CpNc=0, CpNd=0;
     double  SpI=0, SpFz=0, SpFzP=0, SpNa=0, SpNb=0, SpNc=0, SpNd=0;
-    //
-    double Na = a_sig+a_qcd+a_ewk, Nb = b_sig+b_qcd+b_ewk;
-    double Nc=c_sig+c_qcd+c_ewk,   Nd = d_sig+d_qcd+d_ewk;
-    double Ea = a_ewk, Eb = b_ewk, Ec=c_ewk, Ed = d_ewk;
     if (A != 0) {
       
       ApI   = -(FzP-Fz);
@@ -954,84 +1067,49 @@ void abcd( vector<TString> file, vector<TString> type, vector<double> weight,
     cout << "Total Statistical Error: " 
 	 << DS << ", (" << DS*100./S << "%)"<< endl;
     cout << "Stat Error percentages are wrt S prediction, not S mc" << endl;
+    abcdToys(Na, Nb, Nc, Nd, Ea, Eb, Ec, Ed, I, dI, Fz, dFz, FzP, dFzP, S, DS);
   }
 
-
+  return PLOTCOMBINER_OK;
 }
 
-void plotMaker(TString histoName, TString wzsignal,
+int plotMaker(TString histoName, TString wzsignal,
 	       vector<TString> file, vector<TString> type, 
 	       vector<double> weight, TString xtitle)
 {
-  gROOT->Reset();
-  gROOT->ProcessLine(".L tdrstyle.C"); 
-  gROOT->ProcessLine("setTDRStyle()");
+  loadStyle();
+  // each file is opened once
+  vector<TString> names(1, histoName);
+  HistoMerger merger(file, type, weight);
+  merger.setCache(gMergeCache, gMergeCacheContent);
+  merger.merge(names, gMergeThreads);
+  merger.write(gMergedHistos);
   // automatic recognition of histogram dimension
   int NBins = 0; double min = 0; double max = -1;
-  for (int i=0; i< (int) file.size(); ++i) {
-    if (weight[i]>0) {
-      TFile f(file[i]);
-      TH1F *h = (TH1F*) f.Get(histoName);
-      NBins = h->GetNbinsX();
-      min = h->GetBinLowEdge(1);
-      max = h->GetBinLowEdge(NBins+1);
-      break;
-    }
-  }
+  merger.binning(histoName, NBins, min, max);
   if (NBins ==0 || (max<min)) {
-    std::cout << "PlotCombiner::abcd error: Could not find valid histograms in file"
+    std::cout << "PlotCombiner::plotMaker error: Could not find valid histograms in file"
               << std::endl;
-    abort();
+    return PLOTCOMBINER_INPUT_ERROR;
   }
   cout << "Histograms with "<< NBins <<" bins  and range " << min << "-" << max  << endl;
   // Wenu Signal .......................................................
   TH1F h_wenu("h_wenu", "h_wenu", NBins, min, max);
-  int fmax = (int) file.size();
-  for (int i=0; i<fmax; ++i) {
-    if (type[i] == "sig" && weight[i]>0) {
-      TFile f(file[i]);
-      TH1F *h = (TH1F*) f.Get(histoName);
-      h_wenu.Add(h, weight[i]);
-    }
-  }
+  merger.add(h_wenu, histoName, "sig");
   // Bkgs ..............................................................
   //
   // QCD light flavor
   TH1F h_qcd("h_qcd", "h_qcd", NBins, min, max);
-  for (int i=0; i<fmax; ++i) {
-    if (type[i] == "qcd" && weight[i]>0) {
-      TFile f(file[i]);
-      TH1F *h = (TH1F*) f.Get(histoName);
-      h_qcd.Add(h, weight[i]);
-    }
-  }
+  merger.add(h_qcd, histoName, "qcd");
   // QCD heavy flavor
   TH1F h_bce("h_bce", "h_bce", NBins, min, max);
-  for (int i=0; i<fmax; ++i) {
-    if (type[i] == "bce" && weight[i]>0) {
-      TFile f(file[i]);
-      TH1F *h = (TH1F*) f.Get(histoName);
-      h_bce.Add(h, weight[i]);
-    }
-  }
+  merger.add(h_bce, histoName, "bce");
   // QCD Gjets
   TH1F h_gj("h_gj", "h_gj", NBins, min, max);
-  for (int i=0; i<fmax; ++i) {
-    if (type[i] == "gje" && weight[i]>0) {
-      TFile f(file[i]);
-      TH1F *h = (TH1F*) f.Get(histoName);
-      h_gj.Add(h, weight[i]);
-    }
-  }
+  merger.add(h_gj, histoName, "gje");
   // Other EWK bkgs
   TH1F h_ewk("h_ewk", "h_ewk", NBins, min, max);
-  for (int i=0; i<fmax; ++i) {
-    if (type[i] == "ewk" && weight[i]>0) {
-      TFile f(file[i]);
-      TH1F *h = (TH1F*) f.Get(histoName);
-      h_ewk.Add(h, weight[i]);
-    }
-  }
+  merger.add(h_ewk, histoName, "ewk");
   //
   // ok now decide how to plot them:
   // first the EWK bkgs
@@ -1072,8 +1150,7 @@ void plotMaker(TString histoName, TString wzsignal,
 
   c.Print("test.png");
 
-
-
+  return PLOTCOMBINER_OK;
 }
 
 
@@ -1159,3 +1236,130 @@ double CalcABCD
   return Trionym(A, B, C, Na_+Nb_-Ea_-Eb_);
 
 }
+//
+// the statistical error of S from toys: Poisson Na..Nd, Gaussian I, Fz,
+// FzP; compared with the linear error propagation S +- DS. S must be the
+// CalcABCD of the same populations and parameters, the S that the toys
+// solve for, so that both intervals are around the same value
+//
+void abcdToys(double Na, double Nb, double Nc, double Nd,
+	      double Ea, double Eb, double Ec, double Ed,
+	      double I, double dI, double Fz, double dFz,
+	      double FzP, double dFzP, double S, double DS)
+{
+  if (gToys <= 0) return;
+  ABCDToys toys(Na, Nb, Nc, Nd, Ea, Eb, Ec, Ed);
+  toys.setParameter(ABCDScan::I, I, dI);
+  toys.setParameter(ABCDScan::FZ, Fz, dFz);
+  toys.setParameter(ABCDScan::FZP, FzP, dFzP);
+  toys.run(gToys, gMergeThreads, gToySeed);
+  cout << "********************************************************" << endl;
+  cout << "Toys: " << toys.size() << " (" << toys.size()-toys.nValid()
+       << " without solution), seed " << gToySeed << endl;
+  cout << "S=" << S << ", toys median=" << toys.quantile(0.5) << ", mean="
+       << toys.mean() << ", rms=" << toys.rms() << endl;
+  cout << "68% interval: [" << toys.quantile(0.15865) << ", "
+       << toys.quantile(0.84135) << "]" << endl;
+  cout << "95% interval: [" << toys.quantile(0.02275) << ", "
+       << toys.quantile(0.97725) << "]" << endl;
+  cout << "linear error propagation: " << S-DS << ", " << S+DS << endl;
+  cout << "********************************************************" << endl;
+  toys.write(gToyFile);
+}
+//
+// the populations of the ABCD regions from the tuples: N (and the sum of
+// the squared weights N2) and the EWK part E
+//
+void abcdTupleRegions(const ABCDTuples& tuples, int flavour, double cut, bool data,
+		      double *N, double *N2, double *E)
+{
+  // A, B, C, D: selected above, below, inverse below, above
+  const int selection[4] = {ABCDTuples::SELECTED, ABCDTuples::SELECTED,
+			    ABCDTuples::INVERSE, ABCDTuples::INVERSE};
+  const bool above[4] = {true, false, false, true};
+  for (int r=0; r<4; ++r) {
+    N[r] = 0.;  N2[r] = 0.;
+    for (int s=0; s<ABCDTuples::NSAMPLES; ++s) {
+      if (data && s != ABCDTuples::DATA) continue;
+      double w2;
+      N[r] += tuples.count(s, flavour, selection[r], above[r], cut, &w2);
+      N2[r] += w2;
+    }
+    E[r] = tuples.count(ABCDTuples::EWK, flavour, selection[r], above[r], cut);
+  }
+}
+
+//
+// the ABCD method from the tuples: every file is read once, then the
+// result for any MET cut and MET flavour comes from the tables
+//
+int abcdTuples(vector<TString> file, vector<TString> type, vector<double> weight,
+	       double METCut, double I, double dI, double Fz, double dFz,
+	       double FzP, double dFzP, ABCDTupleCuts cuts, bool data)
+{
+  ABCDTuples tuples(cuts);
+  for (int i=0; i<(int) file.size(); ++i) {
+    if (weight[i] <= 0) continue;
+    const int sample = ABCDTuples::sample(type[i]);
+    if (sample < 0) {
+      cout << "abcdTuples: unknown type " << type[i] << " of " << file[i]
+	   << ", file ignored" << endl;
+      continue;
+    }
+    if (!tuples.fill(file[i], sample, weight[i])) return PLOTCOMBINER_INPUT_ERROR;
+  }
+  tuples.finish();
+  //
+  TFile out(gMetScanFile, "RECREATE");
+  TTree tree("abcd_met_scan", "ABCD vs MET cut");
+  int flavour, valid;
+  double cut, N[4], N2[4], E[4], S, DS;
+  tree.Branch("flavour", &flavour, "flavour/I");   // 0 calo, 1 pf, 2 tc
+  tree.Branch("cut", &cut, "cut/D");
+  tree.Branch("N", N, "N[4]/D");
+  tree.Branch("E", E, "E[4]/D");
+  tree.Branch("S", &S, "S/D");
+  tree.Branch("DS", &DS, "DS/D");
+  tree.Branch("valid", &valid, "valid/I");
+  const double dp[3] = {dI, dFz, dFzP};
+  const int nCuts = gMetScanStep > 0 ?
+    int((gMetScanMax - gMetScanMin)/gMetScanStep + 1.5) : 0;
+  for (flavour=0; flavour<ABCDTuples::NFLAVOURS; ++flavour) {
+    double bestCut = -1, bestS = 0, bestDS = 0;
+    // the cut of the input first, then the scan
+    for (int k=-1; k<nCuts; ++k) {
+      cut = k < 0 ? METCut : gMetScanMin + k*gMetScanStep;
+      abcdTupleRegions(tuples, flavour, cut, data, N, N2, E);
+      double grad[ABCDScan::NPAR], gradN[4];
+      valid = abcdWithGradient(I, Fz, FzP, 1., 1., N[0], N[1], N[2], N[3],
+			       E[0], E[1], E[2], E[3], S, grad);
+      abcdCountGradient(I, Fz, FzP, 1., 1., N[0], N[1], N[2], N[3],
+			E[0], E[1], E[2], E[3], S, gradN);
+      double DS2 = 0;
+      for (int r=0; r<4; ++r) DS2 += gradN[r]*gradN[r]*N2[r];
+      for (int p=0; p<3; ++p) DS2 += grad[p]*dp[p]*grad[p]*dp[p];
+      DS = sqrt(DS2);
+      if (k < 0) {
+	cout << "********************************************************" << endl;
+	cout << ABCDTuples::flavourName(flavour) << " MET > " << cut
+	     << ": Signal Prediction: " << S << "+-" << DS << "(stat)" << endl;
+	cout << "A: N=" << N[0] << ", B: N=" << N[1] << ", C: N=" << N[2]
+	     << ", D: N=" << N[3] << endl;
+	cout << "A: ewk=" << E[0] << ", B: ewk=" << E[1] << ", C: ewk=" << E[2]
+	     << ", D: ewk=" << E[3] << endl;
+	continue;
+      }
+      tree.Fill();
+      if (valid && S > 0 && (bestCut < 0 || DS/S < bestDS/bestS)) {
+	bestCut = cut;  bestS = S;  bestDS = DS;
+      }
+    }
+    if (bestCut >= 0)
+      cout << "smallest stat error: MET > " << bestCut << ", S=" << bestS
+	   << "+-" << bestDS << " (" << 100.*bestDS/bestS << "%)" << endl;
+  }
+  tree.Write();
+  out.Close();
+  cout << "MET cut scan in " << gMetScanFile << endl;
+  return PLOTCOMBINER_OK;
+}
@@ -0,0 +1,414 @@
+/*
+     TagProbeEfficiency: efficiencies from the probe_tree of the
+     GenPurposeSkimmer, in bins of probe ET x eta (x run), with Clopper-
+     Pearson intervals
+
+     A probe (one of the 4 of an entry, probe_sc_et > 0) enters the
+     denominator if it is in the binning and passes all the requirements;
+     it enters the numerator of a test if it also passes the test. Tests
+     and requirements are either
+       flags: an int branch, e.g. probe_trigger_cut (column = filter), != 0
+       cuts:  a double branch, e.g. probe_isolation_value, < or > a value
+
+     The probe trees are cut in their clusters (TTree::GetClusterIterator);
+     the threads take the clusters one after the other, each with its own
+     TFile and its own table of pass/total counts. The tables are added
+     at the end; the counts are integers, so the result does not depend on
+     the number of threads. All the tests come from the same pass.
+
+     Usage (see bin/tagProbeEfficiency.cpp):
+       TagProbeEfficiency eff;
+       eff.setBins(etEdges, etaEdges, runEdges, true);   // true: |eta|
+       eff.addFlag("hlt", "probe_trigger_cut", 0);
+       eff.addCut("iso", "probe_isolation_value", true, 0.1);
+       eff.run(files, nThreads);
+       eff.print(0.683);  eff.write("efficiencies.root", 0.683);
+
+     19 Oct 26: first version
+     19 Oct 26: a file that cannot be opened skips its units
+*/
+#ifndef TagProbeEfficiency_H
+#define TagProbeEfficiency_H
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <vector>
+#include "TString.h"
+#include "TROOT.h"
+#include "TFile.h"
+#include "TTree.h"
+#include "TLeaf.h"
+#include "TH1.h"
+#include "TH2D.h"
+#include "TEfficiency.h"
+#if !defined(__CINT__) && !defined(__MAKECINT__)
+#include <atomic>
+#include <thread>
+#define TAGPROBEEFFICIENCY_THREADS
+#endif
+
+class TagProbeEfficiency {
+ public:
+  enum { MAX_PROBES = 4 };
+  enum Kind { FLAG = 0, LESS, GREATER };
+
+  TagProbeEfficiency(): absEta_(true)
+  {
+    etEdges_.push_back(0.);  etEdges_.push_back(1.e9);
+    etaEdges_.push_back(0.);  etaEdges_.push_back(1.e9);
+    runEdges_.push_back(0.);  runEdges_.push_back(4.e9);
+  }
+  //
+  // the bin edges; absEta: bins in |eta|; runs: [first, last) of each bin
+  void setBins(const std::vector<double>& et, const std::vector<double>& eta,
+	       const std::vector<double>& runs, bool absEta)
+  {
+    if (et.size() > 1) etEdges_ = et;
+    if (eta.size() > 1) etaEdges_ = eta;
+    if (runs.size() > 1) runEdges_ = runs;
+    absEta_ = absEta;
+  }
+  //
+  // the tests, and the requirements of the denominator
+  void addFlag(const TString& name, const TString& branch, int column = 0)
+  {
+    tests_.push_back(Test(name, branch, FLAG, column, 0.));
+  }
+  void addCut(const TString& name, const TString& branch, bool less, double cut)
+  {
+    tests_.push_back(Test(name, branch, less ? LESS : GREATER, 0, cut));
+  }
+  void requireFlag(const TString& branch, int column = 0)
+  {
+    requirements_.push_back(Test(branch, branch, FLAG, column, 0.));
+  }
+  void requireCut(const TString& branch, bool less, double cut)
+  {
+    requirements_.push_back(Test(branch, branch, less ? LESS : GREATER, 0, cut));
+  }
+  //
+  // one pass over the probe_tree of all the files; nThreads = 0: one per
+  // core. false if a file or a branch is missing
+  bool run(const std::vector<TString>& files, int nThreads = 0)
+  {
+    files_ = files;
+    units_.clear();
+    for (int f=0; f<(int) files_.size(); ++f) {
+      TFile file(files_[f]);
+      TTree *tree = file.IsZombie() ? 0 : (TTree*) file.Get("probe_tree");
+      if (tree == 0) {
+	std::cout << "TagProbeEfficiency: no probe_tree in " << files_[f]
+		  << std::endl;
+	return false;
+      }
+      if (!checkBranches(tree)) return false;
+      const long long n = tree->GetEntries();
+      TTree::TClusterIterator clusters = tree->GetClusterIterator(0);
+      long long start;
+      while ((start = clusters()) < n)
+	units_.push_back(Unit(f, start, std::min(clusters.GetNextEntry(), n)));
+      file.Close();
+    }
+    const int nUnits = units_.size();
+    std::vector<Table> tables;
+#ifdef TAGPROBEEFFICIENCY_THREADS
+    if (nThreads <= 0) nThreads = std::thread::hardware_concurrency();
+    if (nThreads > nUnits) nThreads = nUnits;
+    if (nThreads > 1) {
+      ROOT::EnableThreadSafety();
+      tables.assign(nThreads, Table(nBins(), tests_.size()));
+      std::atomic<int> next(0);
+      std::vector<std::thread> threads;
+      for (int t=0; t<nThreads; ++t)
+	threads.push_back(std::thread(Worker(this, &tables[t], &next)));
+      for (int t=0; t<nThreads; ++t) threads[t].join();
+    }
+    else
+#endif
+    {
+      tables.assign(1, Table(nBins(), tests_.size()));
+      Reader reader(this);
+      for (int u=0; u<nUnits; ++u) reader.process(units_[u], tables[0]);
+    }
+    total_.assign(nBins(), 0);
+    pass_.assign(nBins()*tests_.size(), 0);
+    for (int t=0; t<(int) tables.size(); ++t) {
+      for (int k=0; k<(int) total_.size(); ++k) total_[k] += tables[t].total[k];
+      for (int k=0; k<(int) pass_.size(); ++k) pass_[k] += tables[t].pass[k];
+    }
+    return true;
+  }
+  //
+  // the counts of a bin
+  int nEt() const { return etEdges_.size()-1; }
+  int nEta() const { return etaEdges_.size()-1; }
+  int nRuns() const { return runEdges_.size()-1; }
+  int nTests() const { return tests_.size(); }
+  long long total(int run, int et, int eta) const
+  {
+    return total_[bin(run, et, eta)];
+  }
+  long long pass(int test, int run, int et, int eta) const
+  {
+    return pass_[bin(run, et, eta)*tests_.size() + test];
+  }
+  //
+  // efficiency and its Clopper-Pearson interval at confidence level cl
+  double efficiency(int test, int run, int et, int eta, double cl,
+		    double& low, double& up) const
+  {
+    const long long n = total(run, et, eta), k = pass(test, run, et, eta);
+    low = TEfficiency::ClopperPearson(n, k, cl, false);
+    up = TEfficiency::ClopperPearson(n, k, cl, true);
+    return n > 0 ? double(k)/n : 0.;
+  }
+  //
+  // the tables
+  void print(double cl) const
+  {
+    for (int t=0; t<(int) tests_.size(); ++t) {
+      std::cout << "efficiency of " << tests_[t].name << " (" << 100.*cl
+		<< "% CL Clopper-Pearson)" << std::endl;
+      for (int r=0; r<nRuns(); ++r) {
+	if (nRuns() > 1)
+	  std::cout << " runs [" << runEdges_[r] << ", " << runEdges_[r+1]
+		    << ")" << std::endl;
+	for (int i=0; i<nEt(); ++i)
+	  for (int j=0; j<nEta(); ++j) {
+	    double low, up;
+	    const double e = efficiency(t, r, i, j, cl, low, up);
+	    std::cout << "  ET [" << etEdges_[i] << ", " << etEdges_[i+1]
+		      << ") eta [" << etaEdges_[j] << ", " << etaEdges_[j+1]
+		      << "): " << pass(t, r, i, j) << "/" << total(r, i, j)
+		      << " = " << e << " [" << low << ", " << up << "]"
+		      << std::endl;
+	  }
+      }
+    }
+  }
+  //
+  // per test and run bin: eff_<test>, its low and up edges, the pass
+  // and total counts, as TH2D in ET x eta (suffix _run<k> if more runs)
+  bool write(const TString& outputFile, double cl) const
+  {
+    TFile out(outputFile, "RECREATE");
+    if (out.IsZombie()) {
+      std::cout << "TagProbeEfficiency: could not create " << outputFile
+		<< std::endl;
+      return false;
+    }
+    const bool addDirectory = TH1::AddDirectoryStatus();
+    TH1::AddDirectory(false);
+    for (int t=0; t<(int) tests_.size(); ++t)
+      for (int r=0; r<nRuns(); ++r) {
+	TString suffix = tests_[t].name;
+	if (nRuns() > 1) suffix += TString::Format("_run%d", r);
+	TH2D *h[5];
+	const char *prefix[5] = {"eff_", "eff_low_", "eff_up_", "pass_", "total_"};
+	for (int k=0; k<5; ++k)
+	  h[k] = new TH2D(prefix[k] + suffix, prefix[k] + suffix,
+			  nEt(), &etEdges_[0], nEta(), &etaEdges_[0]);
+	for (int i=0; i<nEt(); ++i)
+	  for (int j=0; j<nEta(); ++j) {
+	    double low, up;
+	    const double e = efficiency(t, r, i, j, cl, low, up);
+	    h[0]->SetBinContent(i+1, j+1, e);
+	    h[1]->SetBinContent(i+1, j+1, low);
+	    h[2]->SetBinContent(i+1, j+1, up);
+	    h[3]->SetBinContent(i+1, j+1, pass(t, r, i, j));
+	    h[4]->SetBinContent(i+1, j+1, total(r, i, j));
+	  }
+	out.cd();
+	for (int k=0; k<5; ++k) { h[k]->Write();  delete h[k]; }
+      }
+    TH1::AddDirectory(addDirectory);
+    out.Close();
+    std::cout << "TagProbeEfficiency: efficiencies in " << outputFile << std::endl;
+    return true;
+  }
+
+ private:
+  struct Test {
+    Test(const TString& n, const TString& b, Kind k, int c, double v):
+      name(n), branch(b), kind(k), column(c), cut(v) {}
+    TString name, branch;
+    Kind kind;
+    int column;
+    double cut;
+  };
+  struct Unit {
+    Unit(int f, long long s, long long e): file(f), first(s), last(e) {}
+    int file;
+    long long first, last;
+  };
+  struct Table {
+    Table(int nBins, int nTests): total(nBins), pass(nBins*nTests) {}
+    std::vector<long long> total, pass;
+  };
+  //
+  // the branches of one thread
+  class Reader {
+   public:
+    explicit Reader(const TagProbeEfficiency *e): eff_(e), file_(0), tree_(0),
+      current_(-1), run_(0) {}
+    ~Reader() { delete file_; }
+    void process(const Unit& u, Table& table)
+    {
+      if (u.file != current_ && !open(u.file)) return;
+      const int nTests = eff_->tests_.size();
+      for (long long i=u.first; i<u.last; ++i) {
+	tree_->GetEntry(i);
+	const int r = TagProbeEfficiency::find(eff_->runEdges_, run_);
+	if (r < 0) continue;
+	for (int p=0; p<MAX_PROBES; ++p) {
+	  if (!(et_[p] > 0.)) continue;
+	  const int b = eff_->bin(r, et_[p], eff_->absEta_ ? std::fabs(eta_[p]) : eta_[p]);
+	  if (b < 0) continue;
+	  bool required = true;
+	  for (int q=0; q<(int) eff_->requirements_.size() && required; ++q)
+	    required = passes(eff_->requirements_[q], req_[q], p);
+	  if (!required) continue;
+	  ++table.total[b];
+	  for (int t=0; t<nTests; ++t)
+	    if (passes(eff_->tests_[t], val_[t], p)) ++table.pass[b*nTests + t];
+	}
+      }
+    }
+   private:
+    struct Value {
+      std::vector<int> flags;
+      double cut[MAX_PROBES];
+      int columns;
+    };
+    bool passes(const Test& t, const Value& v, int p) const
+    {
+      if (t.kind == FLAG) return v.flags[p*v.columns + t.column] != 0;
+      return t.kind == LESS ? v.cut[p] < t.cut : v.cut[p] > t.cut;
+    }
+    // current_ is f only if it is open: a file that cannot be read is
+    // tried again, and its units skipped, for every unit
+    bool open(int f)
+    {
+      delete file_;
+      file_ = new TFile(eff_->files_[f]);
+      tree_ = file_->IsZombie() ? 0 : (TTree*) file_->Get("probe_tree");
+      if (tree_ == 0) {
+	std::cout << "TagProbeEfficiency: cannot read probe_tree in " << eff_->files_[f]
+		  << ", its entries are skipped" << std::endl;
+	delete file_;
+	file_ = 0;
+	current_ = -1;
+	return false;
+      }
+      current_ = f;
+      tree_->SetBranchStatus("*", 0);
+      connect("probe_sc_et", et_);
+      connect("probe_sc_eta", eta_);
+      connect("event_run", &run_);
+      val_.resize(eff_->tests_.size());
+      for (int t=0; t<(int) eff_->tests_.size(); ++t) book(eff_->tests_[t], val_[t]);
+      req_.resize(eff_->requirements_.size());
+      for (int q=0; q<(int) eff_->requirements_.size(); ++q)
+	book(eff_->requirements_[q], req_[q]);
+      return true;
+    }
+    void book(const Test& t, Value& v)
+    {
+      if (t.kind == FLAG) {
+	const int len = tree_->GetLeaf(t.branch)->GetLen();
+	v.columns = std::max(1, len/MAX_PROBES);
+	v.flags.assign(MAX_PROBES*v.columns, 0);
+	connect(t.branch, &v.flags[0]);
+      }
+      else connect(t.branch, v.cut);
+    }
+    void connect(const char *branch, void *address)
+    {
+      tree_->SetBranchStatus(branch, 1);
+      tree_->SetBranchAddress(branch, address);
+    }
+    const TagProbeEfficiency *eff_;
+    TFile *file_;
+    TTree *tree_;
+    int current_;
+    double et_[MAX_PROBES], eta_[MAX_PROBES];
+    unsigned int run_;
+    std::vector<Value> val_, req_;
+  };
+#ifdef TAGPROBEEFFICIENCY_THREADS
+  struct Worker {
+    Worker(const TagProbeEfficiency *e, Table *t, std::atomic<int> *n):
+      eff(e), table(t), next(n) {}
+    void operator()() {
+      Reader reader(eff);
+      for (int u = (*next)++; u < (int) eff->units_.size(); u = (*next)++)
+	reader.process(eff->units_[u], *table);
+    }
+    const TagProbeEfficiency *eff;
+    Table *table;
+    std::atomic<int> *next;
+  };
+#endif
+  //
+  // the branches of the tests are there and have the expected shape
+  bool checkBranches(TTree *tree) const
+  {
+    const char *always[3] = {"probe_sc_et", "probe_sc_eta", "event_run"};
+    bool ok = true;
+    for (int k=0; k<3; ++k) ok = checkBranch(tree, always[k]) && ok;
+    for (int t=0; t<(int) tests_.size(); ++t) ok = checkTest(tree, tests_[t]) && ok;
+    for (int q=0; q<(int) requirements_.size(); ++q)
+      ok = checkTest(tree, requirements_[q]) && ok;
+    return ok;
+  }
+  static bool checkBranch(TTree *tree, const TString& branch)
+  {
+    if (tree->GetLeaf(branch) != 0) return true;
+    std::cout << "TagProbeEfficiency: no branch " << branch << std::endl;
+    return false;
+  }
+  static bool checkTest(TTree *tree, const Test& t)
+  {
+    if (!checkBranch(tree, t.branch)) return false;
+    TLeaf *leaf = tree->GetLeaf(t.branch);
+    const int len = leaf->GetLen();
+    const TString type = t.kind == FLAG ? "Int_t" : "Double_t";
+    if (type != leaf->GetTypeName()) {
+      std::cout << "TagProbeEfficiency: " << t.branch << " is not " << type
+		<< std::endl;
+      return false;
+    }
+    if (len % MAX_PROBES != 0 || (t.kind != FLAG && len != MAX_PROBES) ||
+	t.column < 0 || t.column >= len/MAX_PROBES) {
+      std::cout << "TagProbeEfficiency: " << t.branch << " has " << len
+		<< " values per entry, column " << t.column << " asked" << std::endl;
+      return false;
+    }
+    return true;
+  }
+  //
+  // the bin [i, i+1) of x, -1 if outside
+  static int find(const std::vector<double>& edges, double x)
+  {
+    const int i = std::upper_bound(edges.begin(), edges.end(), x) - edges.begin() - 1;
+    return (i < 0 || i >= (int) edges.size()-1) ? -1 : i;
+  }
+  int bin(int run, double et, double eta) const
+  {
+    const int i = find(etEdges_, et), j = find(etaEdges_, eta);
+    if (i < 0 || j < 0) return -1;
+    return (run*nEt() + i)*nEta() + j;
+  }
+  int bin(int run, int et, int eta) const { return (run*nEt() + et)*nEta() + eta; }
+  int nBins() const { return nRuns()*nEt()*nEta(); }
+
+  std::vector<double> etEdges_, etaEdges_, runEdges_;
+  bool absEta_;
+  std::vector<Test> tests_, requirements_;
+  std::vector<TString> files_;
+  std::vector<Unit> units_;
+  std::vector<long long> total_, pass_;
+};
+
+#endif
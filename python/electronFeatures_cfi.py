@@ -0,0 +1,11 @@
+import FWCore.ParameterSet.Config as cms
+
+## the electron variables of WenuPlots and of the skimmers, computed once
+## per event: one ValueMap<float> per feature, e.g.
+##     cms.InputTag("electronFeatures", "trackIso03")
+## the consumers take the module label (electronFeatures parameter)
+
+electronFeatures = cms.EDProducer("ElectronFeatureProducer",
+    src = cms.InputTag("gsfElectrons"),
+    beamSpot = cms.InputTag("offlineBeamSpot"),
+)
@@ -0,0 +1,21 @@
+import FWCore.ParameterSet.Config as cms
+
+## gen level acceptance for all the members of a PDF set in one pass:
+## per member sums and acceptance in outputfile, the central acceptance
+## and its asymmetric Hessian uncertainty printed at the end of the job
+## (see interface/PdfAcceptance.h). Needs all the events: put it in front
+## of any filter.
+
+pdfAcceptance = cms.EDAnalyzer("PdfAcceptance",
+    pdfSet = cms.untracked.string("cteq66"),
+    # CTEQ66 uncertainties are 90% CL: 1.645 for 68% CL
+    hessianScale = cms.untracked.double(1.),
+    genEventInfo = cms.untracked.InputTag("generator"),
+    MCCollection = cms.untracked.InputTag("genParticles"),
+    motherId = cms.untracked.int32(24),
+    minEt = cms.untracked.double(25.),
+    BarrelMaxEta = cms.untracked.double(1.4442),
+    EndcapMinEta = cms.untracked.double(1.566),
+    EndcapMaxEta = cms.untracked.double(2.5),
+    outputfile = cms.untracked.string("pdfAcceptance.root"),
+)
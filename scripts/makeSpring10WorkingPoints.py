@@ -0,0 +1,152 @@
+#!/usr/bin/env python
+"""
+  makeSpring10WorkingPoints.py
+  ============================
+  Writes interface/Spring10WorkingPoints.h, the compile time tables of
+  the Spring10 working points, from the selection blocks
+  python/simpleCutBasedSpring10SelectionBlocks_cfi.py: one type per
+  selection_<name> block for WenuFixedSelector, with the thresholds in
+  the CutVars_ order of WenuPlots (the cuts that are not in the block
+  have the WenuPlots default, 1000: no cut).
+
+  usage (from the package directory, after any change of the blocks):
+    scripts/makeSpring10WorkingPoints.py [blocks] [header]
+
+  The blocks are read as text, so that no CMSSW environment is needed.
+
+  Changes Log:
+  ------------
+  19.10.26: first version
+  19.10.26: spring10Cuts, the cuts of a block by name
+"""
+import re
+import sys
+
+# the CutVars_ of WenuPlots, and the default of a cut not in the block
+VARIABLES = ["trackIso", "ecalIso", "hcalIso", "sihih", "dphi", "deta", "hoe",
+             "cIso", "tip_bspot", "eop", "trackIsoUser", "ecalIsoUser", "hcalIsoUser"]
+DEFAULT_CUT = 1000.
+
+def readBlocks(fileName):
+    blocks = []
+    current = None
+    for line in open(fileName):
+        m = re.match(r"\s*selection_(\w+)\s*=\s*cms\.PSet", line)
+        if m:
+            current = {"name": m.group(1), "cuts": {}, "bools": {}, "ints": {}}
+            blocks.append(current)
+            continue
+        if current is None:
+            continue
+        m = re.match(r"\s*(\w+)_(EB|EE)\s*=\s*cms\.untracked\.double\(\s*([^)\s]+)\s*\)", line)
+        if m:
+            value = float(m.group(3))
+            # the table is written with %g
+            if float("%g" % value) != value:
+                sys.exit("makeSpring10WorkingPoints.py: %s has more than 6 digits" % m.group(3))
+            current["cuts"][(m.group(1), m.group(2))] = value
+            continue
+        m = re.match(r"\s*(\w+)\s*=\s*cms\.untracked\.bool\(\s*(True|False)\s*\)", line)
+        if m:
+            current["bools"][m.group(1)] = m.group(2) == "True"
+            continue
+        m = re.match(r"\s*(\w+)\s*=\s*cms\.untracked\.int32\(\s*(-?\d+)\s*\)", line)
+        if m:
+            current["ints"][m.group(1)] = int(m.group(2))
+    return blocks
+
+def header(blocks, source):
+    out = []
+    out.append("#ifndef Spring10WorkingPoints_H")
+    out.append("#define Spring10WorkingPoints_H")
+    out.append("/*")
+    out.append("  Spring10WorkingPoints")
+    out.append("  =====================")
+    out.append("  Generated by scripts/makeSpring10WorkingPoints.py from")
+    out.append("  %s: do not edit, run the script again." % source)
+    out.append("")
+    out.append("  One type per selection block for WenuFixedSelector, with the cuts")
+    out.append("  in the CutVars_ order of WenuPlots (EB, EE), the preselection of the")
+    out.append("  block and cuts() for the runtime WenuSelector; spring10Selection")
+    out.append("  finds the fixed selector of a block by name (\"80relIso\"),")
+    out.append("  spring10Cuts its cuts.")
+    out.append("*/")
+    out.append("#include <string>")
+    out.append("#include <vector>")
+    out.append("")
+    out.append('#include "ElectroWeakAnalysis/WENu/interface/WenuFixedSelector.h"')
+    out.append("")
+    out.append("namespace spring10 {")
+    out.append("  // " + ", ".join(VARIABLES))
+    for b in blocks:
+        values = []
+        for region in ("EB", "EE"):
+            values.append(", ".join("%g" % b["cuts"].get((v, region), DEFAULT_CUT)
+                                    for v in VARIABLES))
+        out.append("  constexpr double wp%s[2*WenuSelectorVars::NVARS] = {" % b["name"])
+        out.append("    %s," % values[0])
+        out.append("    %s};" % values[1])
+    out.append("}")
+    out.append("")
+    for b in blocks:
+        t = "Spring10WP%s" % b["name"]
+        table = "spring10::wp%s" % b["name"]
+        out.append("struct %s {" % t)
+        out.append('  static const char *name() { return "%s"; }' % b["name"])
+        out.append("  static constexpr double cutEB(int i) { return %s[i]; }" % table)
+        out.append("  static constexpr double cutEE(int i) { return %s[i+WenuSelectorVars::NVARS]; }"
+                   % table)
+        out.append("  static constexpr bool useConversionRejection = %s;"
+                   % ("true" if b["bools"].get("useConversionRejection", False) else "false"))
+        out.append("  static constexpr bool useExpectedMissingHits = %s;"
+                   % ("true" if b["bools"].get("useExpectedMissingHits", False) else "false"))
+        out.append("  static constexpr int maxNumberOfExpectedMissingHits = %d;"
+                   % b["ints"].get("maxNumberOfExpectedMissingHits", 1))
+        out.append("  static std::vector<double> cuts() {")
+        out.append("    return std::vector<double>(%s, %s + 2*WenuSelectorVars::NVARS);"
+                   % (table, table))
+        out.append("  }")
+        out.append("};")
+        out.append("")
+    out.append("// the fixed selector of the block selection_<name>, 0 if there is none")
+    out.append("template <class Accessor>")
+    out.append("typename WenuFixedSelection<Accessor>::Function")
+    out.append("spring10Selection(const std::string& name)")
+    out.append("{")
+    for b in blocks:
+        out.append('  if (name == "%s")' % b["name"])
+        out.append("    return &WenuFixedSelector<Spring10WP%s>::template passes<Accessor>;"
+                   % b["name"])
+    out.append("  return 0;")
+    out.append("}")
+    out.append("")
+    out.append("// the cuts of the block selection_<name>, empty if there is none")
+    out.append("inline std::vector<double> spring10Cuts(const std::string& name)")
+    out.append("{")
+    for b in blocks:
+        out.append('  if (name == "%s") return Spring10WP%s::cuts();' % (b["name"], b["name"]))
+    out.append("  return std::vector<double>();")
+    out.append("}")
+    out.append("")
+    out.append("// all the names, in the order of the blocks")
+    out.append("inline std::vector<std::string> spring10WorkingPoints()")
+    out.append("{")
+    out.append("  std::vector<std::string> names;")
+    for b in blocks:
+        out.append('  names.push_back("%s");' % b["name"])
+    out.append("  return names;")
+    out.append("}")
+    out.append("")
+    out.append("#endif")
+    return "\n".join(out) + "\n"
+
+if __name__ == "__main__":
+    source = "python/simpleCutBasedSpring10SelectionBlocks_cfi.py"
+    target = "interface/Spring10WorkingPoints.h"
+    if len(sys.argv) > 1: source = sys.argv[1]
+    if len(sys.argv) > 2: target = sys.argv[2]
+    blocks = readBlocks(source)
+    if not blocks:
+        sys.exit("makeSpring10WorkingPoints.py: no selection block in " + source)
+    open(target, "w").write(header(blocks, source))
+    print("makeSpring10WorkingPoints.py: %d working points in %s" % (len(blocks), target))
@@ -0,0 +1,52 @@
+#include "ElectroWeakAnalysis/WENu/interface/ElectronFeatureProducer.h"
+#include "ElectroWeakAnalysis/WENu/interface/ElectronFeatures.h"
+
+#include <vector>
+
+#include "DataFormats/Common/interface/Handle.h"
+#include "DataFormats/Common/interface/ValueMap.h"
+#include "FWCore/Framework/interface/MakerMacros.h"
+
+
+ElectronFeatureProducer::ElectronFeatureProducer(const edm::ParameterSet& ps)
+{
+  electronToken_ = consumes<reco::GsfElectronCollection>(ps.getParameter<edm::InputTag>("src"));
+  beamSpotToken_ = consumes<reco::BeamSpot>(ps.getParameter<edm::InputTag>("beamSpot"));
+  for (int f=0; f<ElectronFeatures::NFEATURES; ++f)
+    produces<edm::ValueMap<float> >(ElectronFeatures::name(f));
+}
+
+ElectronFeatureProducer::~ElectronFeatureProducer()
+{
+}
+
+void
+ElectronFeatureProducer::produce(edm::StreamID, edm::Event& evt,
+				 const edm::EventSetup&) const
+{
+  edm::Handle<reco::GsfElectronCollection> electrons;
+  evt.getByToken(electronToken_, electrons);
+  edm::Handle<reco::BeamSpot> pBeamSpot;
+  evt.getByToken(beamSpotToken_, pBeamSpot);
+  const reco::BeamSpot *beamSpot = pBeamSpot.isValid() ? pBeamSpot.product() : 0;
+  //
+  // electron major while computing, feature major for the maps
+  const unsigned int nEle = electrons->size();
+  const int nF = ElectronFeatures::NFEATURES;
+  std::vector<std::vector<float> > values(nF, std::vector<float>(nEle, 0.));
+  float f[ElectronFeatures::NFEATURES];
+  for (unsigned int i=0; i<nEle; ++i) {
+    ElectronFeatures::compute((*electrons)[i], beamSpot, f);
+    for (int k=0; k<nF; ++k) values[k][i] = f[k];
+  }
+  for (int k=0; k<nF; ++k) {
+    std::unique_ptr<edm::ValueMap<float> > map(new edm::ValueMap<float>());
+    edm::ValueMap<float>::Filler filler(*map);
+    filler.insert(electrons, values[k].begin(), values[k].end());
+    filler.fill();
+    evt.put(std::move(map), ElectronFeatures::name(k));
+  }
+}
+
+//define this as a plug-in
+DEFINE_FWK_MODULE(ElectronFeatureProducer);
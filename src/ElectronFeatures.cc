@@ -0,0 +1,97 @@
+#include "ElectroWeakAnalysis/WENu/interface/ElectronFeatures.h"
+
+#include <cmath>
+
+#include "DataFormats/Candidate/interface/CandidateFwd.h"
+
+
+const char *
+ElectronFeatures::name(int f)
+{
+  static const char *names[NFEATURES] = {
+    "trackIso03", "ecalIso03", "hcalIso03", "trackIso04", "ecalIso04", "hcalIso04",
+    "sigmaIetaIeta", "sigmaEtaEta", "deltaPhiIn", "deltaEtaIn", "hoe", "eop",
+    "pin", "pout", "e1x5", "e2x5Max", "e5x5", "tipBeamSpot", "d0"
+  };
+  return names[f];
+}
+
+void
+ElectronFeatures::compute(const reco::GsfElectron& ele, const reco::BeamSpot *beamSpot,
+			  float *f)
+{
+  f[TRACK_ISO03] = ele.dr03IsolationVariables().tkSumPt;
+  f[ECAL_ISO03]  = ele.dr03IsolationVariables().ecalRecHitSumEt;
+  f[HCAL_ISO03]  = ele.dr03IsolationVariables().hcalDepth1TowerSumEt +
+    ele.dr03IsolationVariables().hcalDepth2TowerSumEt;
+  f[TRACK_ISO04] = ele.dr04IsolationVariables().tkSumPt;
+  f[ECAL_ISO04]  = ele.dr04IsolationVariables().ecalRecHitSumEt;
+  f[HCAL_ISO04]  = ele.dr04IsolationVariables().hcalDepth1TowerSumEt +
+    ele.dr04IsolationVariables().hcalDepth2TowerSumEt;
+  //
+  f[SIHIH] = ele.scSigmaIEtaIEta();
+  // correct if in endcaps, as in the skimmer
+  const double caloEta = ele.caloPosition().eta();
+  double sigmaee = ele.scSigmaEtaEta();
+  if (std::fabs(caloEta) > 1.479) sigmaee = sigmaee - 0.02*(std::fabs(caloEta) - 2.3);
+  f[SIGMAEE] = sigmaee;
+  f[DPHI_IN] = ele.deltaPhiSuperClusterTrackAtVtx();
+  f[DETA_IN] = ele.deltaEtaSuperClusterTrackAtVtx();
+  f[HOE]     = ele.hadronicOverEm();
+  f[EOP]     = ele.eSuperClusterOverP();
+  f[PIN]     = ele.trackMomentumAtVtx().R();
+  f[POUT]    = ele.trackMomentumOut().R();
+  f[E1X5]    = ele.scE1x5();
+  f[E2X5MAX] = ele.scE2x5Max();
+  f[E5X5]    = ele.scE5x5();
+  //
+  f[TIP_BS] = beamSpot ? std::fabs(ele.gsfTrack()->dxy(beamSpot->position()))
+    : std::fabs(ele.gsfTrack()->dxy());
+  f[D0] = ele.gsfTrack()->d0();
+}
+
+ElectronFeatureReader::ElectronFeatureReader(const edm::InputTag& src,
+					     const edm::InputTag& beamSpot,
+					     edm::ConsumesCollector&& iC):
+  useMaps_(src.label().size() > 0)
+{
+  if (useMaps_)
+    for (int f=0; f<ElectronFeatures::NFEATURES; ++f)
+      tokens_[f] = iC.consumes<edm::ValueMap<float> >
+	(edm::InputTag(src.label(), ElectronFeatures::name(f), src.process()));
+  beamSpotToken_ = iC.consumes<reco::BeamSpot>(beamSpot);
+}
+
+void
+ElectronFeatureReader::getMaps(const edm::Event& evt, Maps& maps) const
+{
+  maps.valid = useMaps_;
+  for (int f=0; f<ElectronFeatures::NFEATURES && maps.valid; ++f) {
+    evt.getByToken(tokens_[f], maps.map[f]);
+    maps.valid = maps.map[f].isValid();
+  }
+  // the beam spot is only needed if something is computed, by get()
+  maps.event = &evt;
+  maps.beamSpotRead = false;
+  maps.beamSpot = 0;
+}
+
+void
+ElectronFeatureReader::get(const Maps& maps, const pat::Electron& ele, float *f) const
+{
+  if (maps.valid) {
+    const reco::CandidateBaseRef orig = ele.originalObjectRef();
+    if (orig.isNonnull() && maps.map[0]->contains(orig.id())) {
+      for (int k=0; k<ElectronFeatures::NFEATURES; ++k)
+	f[k] = maps.map[k]->get(orig.id(), orig.key());
+      return;
+    }
+  }
+  if (not maps.beamSpotRead && maps.event) {
+    edm::Handle<reco::BeamSpot> pBeamSpot;
+    maps.event->getByToken(beamSpotToken_, pBeamSpot);
+    maps.beamSpot = pBeamSpot.isValid() ? pBeamSpot.product() : 0;
+    maps.beamSpotRead = true;
+  }
+  ElectronFeatures::compute(ele, maps.beamSpot, f);
+}
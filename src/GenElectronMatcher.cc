@@ -0,0 +1,107 @@
+#include "ElectroWeakAnalysis/WENu/interface/GenElectronMatcher.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "DataFormats/Math/interface/deltaPhi.h"
+#include "FWCore/MessageLogger/interface/MessageLogger.h"
+
+
+GenElectronMatcher::GenElectronMatcher(double maxDeta, double maxDphi):
+  maxDeta_(maxDeta), maxDphi_(maxDphi), genParticles_(0)
+{
+}
+
+GenElectronMatcher::~GenElectronMatcher()
+{
+}
+
+void
+GenElectronMatcher::setEvent(const reco::GenParticleCollection& genParticles)
+{
+  genParticles_ = &genParticles;
+  electrons_.clear();
+  //
+  // keep only the status 1 electrons: a few out of thousands of particles
+  const unsigned int nGen = genParticles.size();
+  for (unsigned int i=0; i<nGen; ++i) {
+    const reco::GenParticle& gen = genParticles[i];
+    if (gen.status() != 1 || std::abs(gen.pdgId()) != 11) continue;
+    GenElectronEntry entry;
+    entry.eta = gen.eta();  entry.phi = gen.phi();  entry.key = i;
+    electrons_.push_back(entry);
+  }
+  std::sort(electrons_.begin(), electrons_.end());
+  //
+  motherIds_.assign(electrons_.size(), 999);
+  motherResolved_.assign(electrons_.size(), false);
+}
+
+int
+GenElectronMatcher::match(double eta, double phi, GenElectronMatch& result) const
+{
+  result.nMatched = 0;  result.index = -1;
+  result.deta = 999.;   result.dphi = 999.;  result.energy = 999.;
+  //
+  // only the electrons with |eta_gen - eta| < maxDeta_ are candidates
+  GenElectronEntry low, high;
+  low.eta  = eta - maxDeta_;
+  high.eta = eta + maxDeta_;
+  std::vector<GenElectronEntry>::const_iterator first =
+    std::upper_bound(electrons_.begin(), electrons_.end(), low);
+  std::vector<GenElectronEntry>::const_iterator last =
+    std::lower_bound(first, electrons_.end(), high);
+  //
+  double bestDr2 = -1.;
+  for (std::vector<GenElectronEntry>::const_iterator it = first; it != last; ++it) {
+    const double deta = it->eta - eta;
+    const double dphi = reco::deltaPhi(it->phi, phi);
+    if (std::fabs(dphi) >= maxDphi_) continue;
+    ++result.nMatched;
+    // keep the closest one in deltaR
+    const double dr2 = deta*deta + dphi*dphi;
+    if (bestDr2 < 0. || dr2 < bestDr2) {
+      bestDr2 = dr2;
+      result.index = it - electrons_.begin();
+      result.deta = deta;  result.dphi = dphi;
+      result.energy = (*genParticles_)[it->key].energy();
+    }
+  }
+  return result.nMatched;
+}
+
+int
+GenElectronMatcher::motherId(const GenElectronMatch& result) const
+{
+  if (result.index < 0) return 999;
+  return motherId(static_cast<unsigned int>(result.index));
+}
+
+int
+GenElectronMatcher::motherId(unsigned int i) const
+{
+  if (not motherResolved_[i]) {
+    motherIds_[i] = resolveMotherId(electron(i));
+    motherResolved_[i] = true;
+  }
+  return motherIds_[i];
+}
+
+const reco::GenParticle&
+GenElectronMatcher::electron(unsigned int i) const
+{
+  return (*genParticles_)[electrons_[i].key];
+}
+
+int
+GenElectronMatcher::resolveMotherId(const reco::GenParticle& electron) const
+{
+  // skip the electron copies (e.g. after FSR) until a different particle
+  const reco::Candidate *mum = electron.mother();
+  while (mum != 0 && std::abs(mum->pdgId()) == 11) mum = mum->mother();
+  if (mum == 0) {
+    edm::LogInfo("info") << "Going too far to find the mum";
+    return 999;
+  }
+  return mum->pdgId();
+}
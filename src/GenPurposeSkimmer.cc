@@ -0,0 +1,18 @@
+// -*- C++ -*-
+//
+// Package:    GenPurposeSkimmer
+// Class:      GenPurposeSkimmer
+// 
+/**\class GenPurposeSkimmer GenPurposeSkimmer.cc 
+
+ Description: GenPurposeSkimmerT, MC version: the probes are matched to the gen electrons
+
+ Implementation:
+   see interface/GenPurposeSkimmerT.h
+
+*/
+#include "ElectroWeakAnalysis/WENu/interface/GenPurposeSkimmer.h"
+#include "FWCore/Framework/interface/MakerMacros.h"
+
+//define this as a plug-in
+DEFINE_FWK_MODULE(GenPurposeSkimmer);
@@ -0,0 +1,19 @@
+// -*- C++ -*-
+//
+// Package:    GenPurposeSkimmerAcceptance
+// Class:      GenPurposeSkimmerAcceptance
+// 
+/**\class GenPurposeSkimmerAcceptance GenPurposeSkimmerAcceptance.cc 
+
+ Description: GenPurposeSkimmerT, acceptance version: MC matching plus the gen electrons
+   of every event, all events are written
+
+ Implementation:
+   see interface/GenPurposeSkimmerT.h
+
+*/
+#include "ElectroWeakAnalysis/WENu/interface/GenPurposeSkimmerAcceptance.h"
+#include "FWCore/Framework/interface/MakerMacros.h"
+
+//define this as a plug-in
+DEFINE_FWK_MODULE(GenPurposeSkimmerAcceptance);
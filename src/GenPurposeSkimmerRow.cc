@@ -0,0 +1,152 @@
+#include "ElectroWeakAnalysis/WENu/interface/GenPurposeSkimmerRow.h"
+
+
+void
+GenPurposeSkimmerRow::book(TTree *probe_tree)
+{
+  // event id: the stream trees are merged in (run, lumi, event) order
+  probe_tree->Branch("event_run",&event_run,"event_run/i");
+  probe_tree->Branch("event_lumi",&event_lumi,"event_lumi/i");
+  probe_tree->Branch("event_number",&event_number,"event_number/l");
+  //
+  //probe_tree->Branch("probe_ele_eta",probe_ele_eta_for_tree,"probe_ele_eta[4]/D");
+  //probe_tree->Branch("probe_ele_phi",probe_ele_phi_for_tree,"probe_ele_phi[4]/D");
+  //probe_tree->Branch("probe_ele_et",probe_ele_et_for_tree,"probe_ele_et[4]/D");
+  probe_tree->Branch("probe_ele_tip",probe_ele_tip,"probe_ele_tip[4]/D");
+  probe_tree->Branch("probe_ele_vertex_x",probe_ele_Xvertex_for_tree,
+		     "probe_ele_vertex_x[4]/D");
+  probe_tree->Branch("probe_ele_vertex_y",probe_ele_Yvertex_for_tree,
+		     "probe_ele_vertex_y[4]/D");
+  probe_tree->Branch("probe_ele_vertex_z",probe_ele_Zvertex_for_tree,
+		     "probe_ele_vertex_z[4]/D");
+  probe_tree->Branch("probe_sc_eta",probe_sc_eta_for_tree,"probe_sc_eta[4]/D");
+  probe_tree->Branch("probe_sc_phi",probe_sc_phi_for_tree,"probe_sc_phi[4]/D");
+  probe_tree->Branch("probe_sc_et",probe_sc_et_for_tree,"probe_sc_et[4]/D");
+  //
+  probe_tree->Branch("probe_charge",probe_charge_for_tree,"probe_charge[4]/I");
+  //probe_tree->Branch("probe_sc_fiducial_cut",probe_sc_pass_fiducial_cut,
+  //		     "probe_sc_fiducial_cut[4]/I");
+  //probe_tree->Branch("probe_classification",
+  //	    probe_classification_index_for_tree,"probe_classification[4]/I");
+  //
+  // Isolation related variables ........................................
+  //
+  probe_tree->Branch("probe_isolation_value",probe_isolation_value, "probe_isolation_value[4]/D");
+  probe_tree->Branch("probe_ecal_isolation_value",probe_ecal_isolation_value, "probe_ecal_isolation_value[4]/D");
+  probe_tree->Branch("probe_hcal_isolation_value",probe_hcal_isolation_value,"probe_hcal_isolation_value[4]/D");
+  //
+  probe_tree->Branch("probe_iso_user",     probe_iso_user,      "probe_iso_user[4]/D");
+  probe_tree->Branch("probe_ecal_iso_user",probe_ecal_iso_user, "probe_ecal_iso_user[4]/D");
+  probe_tree->Branch("probe_hcal_iso_user",probe_hcal_iso_user, "probe_hcal_iso_user[4]/D");
+
+  //......................................................................
+  // Electron ID Related variables .......................................
+  probe_tree->Branch("probe_ele_hoe",probe_ele_hoe, "probe_ele_hoe[4]/D");
+  //probe_tree->Branch("probe_ele_shh",probe_ele_shh, "probe_ele_shh[4]/D");
+  probe_tree->Branch("probe_ele_sihih",probe_ele_sihih,"probe_ele_sihih[4]/D");
+  probe_tree->Branch("probe_ele_dfi",probe_ele_dfi, "probe_ele_dfi[4]/D");
+  probe_tree->Branch("probe_ele_dhi",probe_ele_dhi, "probe_ele_dhi[4]/D");
+  probe_tree->Branch("probe_ele_eop",probe_ele_eop, "probe_ele_eop[4]/D");
+  probe_tree->Branch("probe_ele_pin",probe_ele_pin, "probe_ele_pin[4]/D");
+  probe_tree->Branch("probe_ele_pout",probe_ele_pout, "probe_ele_pout[4]/D");
+  // probe_tree->Branch("probe_ele_e5x5",probe_ele_e5x5, "probe_ele_e5x5[4]/D");
+  //probe_tree->Branch("probe_ele_e2x5",probe_ele_e2x5, "probe_ele_e2x5[4]/D");
+  //probe_tree->Branch("probe_ele_e1x5",probe_ele_e1x5, "probe_ele_e1x5[4]/D");
+  //
+  // debugging info:
+  //probe_tree->Branch("elec_number_in_event",&elec_number_in_event,"elec_number_in_event/I");
+  probe_tree->Branch("elec_1_duplicate_removal",&elec_1_duplicate_removal,"elec_1_duplicate_removal/I");
+  //
+
+  // Missing ET in the event
+  probe_tree->Branch("event_MET",&event_MET,"event_MET/D");
+  probe_tree->Branch("event_MET_phi",&event_MET_phi,"event_MET_phi/D");
+  //  probe_tree->Branch("event_MET_sig",&event_MET_sig,"event_MET_sig/D");
+  probe_tree->Branch("event_mcMET",&event_mcMET,"event_mcMET/D");
+  probe_tree->Branch("event_mcMET_phi",&event_mcMET_phi,"event_mcMET_phi/D");
+  //
+  probe_tree->Branch("event_tcMET",&event_tcMET,"event_tcMET/D");
+  probe_tree->Branch("event_tcMET_phi",&event_tcMET_phi,"event_tcMET_phi/D");
+  //  probe_tree->Branch("event_tcMET_sig",&event_tcMET_sig,"event_tcMET_sig/D");
+
+  probe_tree->Branch("event_pfMET",&event_pfMET,"event_pfMET/D");
+  probe_tree->Branch("event_pfMET_phi",&event_pfMET_phi,"event_pfMET_phi/D");
+  //  probe_tree->Branch("event_pfMET_sig",&event_pfMET_sig,"event_pfMET_sig/D");
+
+  //..... type 1 corrected MET
+  probe_tree->Branch("event_t1MET", &event_t1MET, "event_t1MET/D");
+  probe_tree->Branch("event_t1MET_phi", &event_t1MET_phi,"event_t1MET_phi/D");
+  //probe_tree->Branch("event_t1MET_sig",&event_t1MET_sig,"event_t1MET_sig/D");
+
+  //
+  // some sc related variables
+  probe_tree->Branch("sc_hybrid_et", sc_hybrid_et, "sc_hybrid_et[5]/D");
+  probe_tree->Branch("sc_hybrid_eta", sc_hybrid_eta, "sc_hybrid_eta[5]/D");
+  probe_tree->Branch("sc_hybrid_phi", sc_hybrid_phi, "sc_hybrid_phi[5]/D");
+  //
+  probe_tree->Branch("sc_multi5x5_et",sc_multi5x5_et, "sc_multi5x5_et[5]/D");
+  probe_tree->Branch("sc_multi5x5_eta",sc_multi5x5_eta,"sc_multi5x5_eta[5]/D");
+  probe_tree->Branch("sc_multi5x5_phi",sc_multi5x5_phi,"sc_multi5x5_phi[5]/D");
+  // /////////////////////////////////////////////////////////////////////////
+  // general tracks in the event: keep 20 tracks
+  probe_tree->Branch("ctf_track_pt",  ctf_track_pt,  "ctf_track_pt[20]/D");
+  probe_tree->Branch("ctf_track_eta", ctf_track_eta, "ctf_track_eta[20]/D");
+  probe_tree->Branch("ctf_track_phi", ctf_track_phi, "ctf_track_phi[20]/D");
+  probe_tree->Branch("ctf_track_vx", ctf_track_vx, "ctf_track_vx[20]/D");
+  probe_tree->Branch("ctf_track_vy", ctf_track_vy, "ctf_track_vy[20]/D");
+  probe_tree->Branch("ctf_track_vz", ctf_track_vz, "ctf_track_vz[20]/D");
+  probe_tree->Branch("ctf_track_tip", ctf_track_tip, "ctf_track_tip[20]/D");
+  probe_tree->Branch("ctf_track_tip_bs", ctf_track_tip_bs,
+		     "ctf_track_tip_bs[20]/D");
+  //
+  probe_tree->Branch("muon_pt",  muon_pt,  "muon_pt[4]/D");
+  probe_tree->Branch("muon_eta", muon_eta, "muon_eta[4]/D");
+  probe_tree->Branch("muon_phi", muon_phi, "muon_phi[4]/D");
+  probe_tree->Branch("muon_vx", muon_vx, "muon_vx[4]/D");
+  probe_tree->Branch("muon_vy", muon_vy, "muon_vy[4]/D");
+  probe_tree->Branch("muon_vz", muon_vz, "muon_vz[4]/D");
+  probe_tree->Branch("muon_tip", muon_tip, "muon_tip[4]/D");
+  probe_tree->Branch("muon_tip_bs", muon_tip_bs, "muon_tip_bs[4]/D");
+}
+
+void
+GenPurposeSkimmerRow::resetProbes()
+{
+  for(int i =0; i < MAX_PROBES; i++){
+    probe_ele_eta_for_tree[i] = -99.0;
+    probe_ele_et_for_tree[i] = -99.0;
+    probe_ele_phi_for_tree[i] = -99.0;
+    probe_ele_Xvertex_for_tree[i] = -99.0;
+    probe_ele_Yvertex_for_tree[i] = -99.0;
+    probe_ele_Zvertex_for_tree[i] = -99.0;
+    probe_ele_tip[i] = -999.;
+
+    probe_sc_eta_for_tree[i] = -99.0;
+    probe_sc_et_for_tree[i] = -99.0;
+    probe_sc_phi_for_tree[i] = -99.0;
+
+    probe_charge_for_tree[i] = -99;
+    probe_sc_pass_fiducial_cut[i] = 0;
+    probe_classification_index_for_tree[i]=-99;
+    //
+    // probe isolation values ............
+    probe_isolation_value[i] = 999.0;
+    probe_iso_user[i] = 999.0;
+    probe_ecal_isolation_value[i] = 999;
+    probe_ecal_iso_user[i] = 999;
+    probe_hcal_isolation_value[i] = 999;
+    probe_hcal_iso_user[i] = 999;
+
+    probe_ele_hoe[i]  = 999.;
+    probe_ele_shh[i]  = 999.;
+    probe_ele_sihih[i] = 999.;
+    probe_ele_dhi[i]  = 999.;
+    probe_ele_dfi[i]  = 999.;
+    probe_ele_eop[i]  = 999.;
+    probe_ele_pin[i]  = 999.;
+    probe_ele_pout[i] = 999.;
+    probe_ele_e5x5[i] = 999.;
+    probe_ele_e2x5[i] = 999.;
+    probe_ele_e1x5[i] = 999.;
+  }
+}
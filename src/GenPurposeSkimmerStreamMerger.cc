@@ -0,0 +1,144 @@
+#include "ElectroWeakAnalysis/WENu/interface/GenPurposeSkimmerStreamMerger.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <iostream>
+#include <sstream>
+
+#include "TFile.h"
+#include "TTree.h"
+#include "TChain.h"
+#include "TList.h"
+#include "TObjString.h"
+
+
+GenPurposeSkimmerStreamMerger::GenPurposeSkimmerStreamMerger(const std::string& outputFile):
+  outputFile_(outputFile)
+{
+}
+
+std::string
+GenPurposeSkimmerStreamMerger::streamFileName(unsigned int stream) const
+{
+  // bkg.root -> bkg_stream0.root
+  std::string base = outputFile_;
+  std::string ext;
+  const std::string::size_type dot = base.rfind(".root");
+  if (dot != std::string::npos && dot + 5 == base.size()) {
+    ext = ".root";
+    base.erase(dot);
+  }
+  std::ostringstream name;
+  name << base << "_stream" << stream << ext;
+  return name.str();
+}
+
+void
+GenPurposeSkimmerStreamMerger::addStreamFile(unsigned int stream,
+					     const std::string& fileName)
+{
+  std::lock_guard<std::mutex> guard(mutex_);
+  // keep the files in stream order, whatever the order the streams end
+  std::vector<unsigned int>::iterator it =
+    std::lower_bound(streams_.begin(), streams_.end(), stream);
+  files_.insert(files_.begin() + (it - streams_.begin()), fileName);
+  streams_.insert(it, stream);
+}
+
+void
+GenPurposeSkimmerStreamMerger::sortedEntries(std::vector<Entry>& entries) const
+{
+  entries.clear();
+  const int nFiles = files_.size();
+  for (int f=0; f<nFiles; ++f) {
+    TFile file(files_[f].c_str());
+    TTree *tree = (TTree*) file.Get("probe_tree");
+    if (tree == 0) {
+      std::cout << "Warning: no probe_tree in " << files_[f] << std::endl;
+      continue;
+    }
+    // read only the event id branches
+    Entry e;
+    e.file = f;
+    tree->SetBranchStatus("*", 0);
+    tree->SetBranchStatus("event_run", 1);
+    tree->SetBranchStatus("event_lumi", 1);
+    tree->SetBranchStatus("event_number", 1);
+    tree->SetBranchAddress("event_run", &e.run);
+    tree->SetBranchAddress("event_lumi", &e.lumi);
+    tree->SetBranchAddress("event_number", &e.event);
+    const long long n = tree->GetEntries();
+    for (e.entry=0; e.entry<n; ++e.entry) {
+      tree->GetEntry(e.entry);
+      entries.push_back(e);
+    }
+    file.Close();
+  }
+  std::sort(entries.begin(), entries.end());
+}
+
+bool
+GenPurposeSkimmerStreamMerger::merge()
+{
+  if (files_.empty()) return false;
+  std::vector<Entry> entries;
+  sortedEntries(entries);
+  //
+  // one stream whose events are already in order: just rename the file
+  bool inOrder = files_.size() == 1;
+  for (unsigned int i=0; inOrder && i<entries.size(); ++i)
+    inOrder = entries[i].entry == (long long) i;
+  if (inOrder && std::rename(files_[0].c_str(), outputFile_.c_str()) == 0)
+    return true;
+  //
+  // the chain keeps the branch addresses of the clone up to date when
+  // it moves from one stream file to another
+  TChain chain("probe_tree");
+  std::vector<long long> offset(files_.size(), 0);
+  long long total = 0;
+  for (unsigned int f=0; f<files_.size(); ++f) {
+    offset[f] = total;
+    chain.Add(files_[f].c_str());
+    total = chain.GetEntries();
+  }
+  TFile *histofile = new TFile(outputFile_.c_str(), "RECREATE");
+  TTree *probe_tree = chain.CloneTree(0);
+  for (unsigned int i=0; i<entries.size(); ++i) {
+    chain.GetEntry(offset[entries[i].file] + entries[i].entry);
+    probe_tree->Fill();
+  }
+  histofile->Write();
+  histofile->Close();
+  delete histofile;
+  //
+  for (unsigned int f=0; f<files_.size(); ++f) std::remove(files_[f].c_str());
+  return true;
+}
+
+bool
+GenPurposeSkimmerStreamMerger::writeIndex()
+{
+  if (files_.empty()) return false;
+  std::vector<Entry> entries;
+  sortedEntries(entries);
+  //
+  TFile *indexfile = new TFile(outputFile_.c_str(), "RECREATE");
+  TTree *index = new TTree("stream_index",
+			   "(run, lumi, event) ordered index of the stream files");
+  Entry e;
+  index->Branch("run", &e.run, "run/i");
+  index->Branch("lumi", &e.lumi, "lumi/i");
+  index->Branch("event", &e.event, "event/l");
+  index->Branch("file", &e.file, "file/I");
+  index->Branch("entry", &e.entry, "entry/L");
+  for (unsigned int i=0; i<entries.size(); ++i) {
+    e = entries[i];
+    index->Fill();
+  }
+  for (unsigned int f=0; f<files_.size(); ++f)
+    index->GetUserInfo()->Add(new TObjString(files_[f].c_str()));
+  indexfile->Write();
+  indexfile->Close();
+  delete indexfile;
+  return true;
+}
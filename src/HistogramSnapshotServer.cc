@@ -0,0 +1,151 @@
+#include "ElectroWeakAnalysis/WENu/interface/HistogramSnapshotServer.h"
+
+#include <cerrno>
+#include <cmath>
+#include <cstring>
+#include <ctime>
+#include <iostream>
+#include <sstream>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+
+void HistogramSnapshot::add(const TH1 *h)
+{
+  Histogram s;
+  s.name = h->GetName();
+  s.nbins = h->GetNbinsX();
+  s.low = h->GetXaxis()->GetXmin();
+  s.high = h->GetXaxis()->GetXmax();
+  s.entries = h->GetEntries();
+  // mean and rms of the bins in range, as TH1::GetMean and GetRMS
+  double stats[4];
+  h->GetStats(stats);
+  s.mean = stats[0] > 0. ? stats[2]/stats[0] : 0.;
+  const double variance = stats[0] > 0. ? stats[3]/stats[0] - s.mean*s.mean : 0.;
+  s.rms = variance > 0. ? std::sqrt(variance) : 0.;
+  s.contents.resize(s.nbins+2);
+  for (int b=0; b<s.nbins+2; ++b) s.contents[b] = h->GetBinContent(b);
+  histograms.push_back(s);
+}
+
+void HistogramSnapshot::write(std::ostream& out, const std::string& module) const
+{
+  out << "snapshot " << module << " events " << events << " time " << time << "\n";
+  for (unsigned int c=0; c<counters.size(); ++c)
+    out << "counter " << counters[c].first << " " << counters[c].second << "\n";
+  for (unsigned int h=0; h<histograms.size(); ++h) {
+    const Histogram& s = histograms[h];
+    out << "histogram " << s.name << " " << s.nbins << " " << s.low << " " << s.high
+	<< " " << s.entries << " " << s.mean << " " << s.rms << "\nbins";
+    for (unsigned int b=0; b<s.contents.size(); ++b) out << " " << s.contents[b];
+    out << "\n";
+  }
+}
+
+/////////////////////////////////////////////////////////////////////////
+
+HistogramSnapshotServer::HistogramSnapshotServer(const std::string& module, int port):
+  module_(module), socket_(-1), stop_(false)
+{
+  if (port <= 0) return;
+  socket_ = socket(AF_INET, SOCK_STREAM, 0);
+  if (socket_ < 0) {
+    std::cout << module_ << ": Warning: no snapshot server, socket: "
+	      << std::strerror(errno) << std::endl;
+    return;
+  }
+  const int on = 1;
+  setsockopt(socket_, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+  sockaddr_in address;
+  std::memset(&address, 0, sizeof(address));
+  address.sin_family = AF_INET;
+  address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  address.sin_port = htons(port);
+  if (bind(socket_, (sockaddr*) &address, sizeof(address)) < 0 || listen(socket_, 4) < 0) {
+    std::cout << module_ << ": Warning: no snapshot server on localhost:" << port
+	      << ": " << std::strerror(errno) << std::endl;
+    close(socket_);
+    socket_ = -1;
+    return;
+  }
+  std::cout << module_ << ": histogram snapshots on http://localhost:" << port
+	    << "/" << std::endl;
+  thread_ = std::thread(&HistogramSnapshotServer::serve, this);
+}
+
+// shutdown wakes the poll of serve at once; the socket is closed only
+// after the join, so that serve never sees its number reused
+HistogramSnapshotServer::~HistogramSnapshotServer()
+{
+  stop_ = true;
+  if (socket_ >= 0) shutdown(socket_, SHUT_RDWR);
+  if (thread_.joinable()) thread_.join();
+  if (socket_ >= 0) close(socket_);
+}
+
+void HistogramSnapshotServer::publish(std::shared_ptr<const HistogramSnapshot> snapshot)
+{
+  std::atomic_store(&current_, snapshot);
+}
+
+// accepts until stop_, looking at it every 200 ms
+void HistogramSnapshotServer::serve()
+{
+  while (not stop_) {
+    pollfd p;
+    p.fd = socket_;
+    p.events = POLLIN;
+    if (poll(&p, 1, 200) <= 0) continue;
+    const int connection = accept(socket_, 0, 0);
+    if (connection < 0) continue;
+    answer(connection);
+    close(connection);
+  }
+}
+
+void HistogramSnapshotServer::answer(int connection)
+{
+  // the request: only the first line matters; a slow client gets 1 s to
+  // send it and 1 s for each part of the answer, a client that stops
+  // reading cannot hold the thread (and the destructor that joins it)
+  timeval timeout;
+  timeout.tv_sec = 1;
+  timeout.tv_usec = 0;
+  setsockopt(connection, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+  setsockopt(connection, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+  char request[1024];
+  const ssize_t n = recv(connection, request, sizeof(request)-1, 0);
+  if (n <= 0) return;
+  request[n] = 0;
+  //
+  std::string status = "200 OK";
+  std::ostringstream body;
+  const std::shared_ptr<const HistogramSnapshot> snapshot = std::atomic_load(&current_);
+  if (std::strncmp(request, "GET / ", 6) != 0 && std::strncmp(request, "GET /\r", 6) != 0) {
+    status = "404 Not Found";
+    body << "only / is served\n";
+  }
+  else if (not snapshot) {
+    status = "503 Service Unavailable";
+    body << "no snapshot yet\n";
+  }
+  else snapshot->write(body, module_);
+  //
+  const std::string text = body.str();
+  std::ostringstream header;
+  header << "HTTP/1.0 " << status << "\r\nContent-Type: text/plain\r\n"
+	 << "Content-Length: " << text.size() << "\r\nConnection: close\r\n\r\n";
+  const std::string answer = header.str() + text;
+  size_t sent = 0;
+  while (sent < answer.size() && not stop_) {
+    const ssize_t s = send(connection, answer.data() + sent, answer.size() - sent, MSG_NOSIGNAL);
+    if (s <= 0) return;
+    sent += s;
+  }
+}
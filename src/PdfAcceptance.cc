@@ -0,0 +1,163 @@
+#include "ElectroWeakAnalysis/WENu/interface/PdfAcceptance.h"
+#include "ElectroWeakAnalysis/WENu/interface/PdfReweighting.h"
+#include "ElectroWeakAnalysis/WENu/interface/GenElectronMatcher.h"
+
+#include <cmath>
+#include <cstdio>
+#include <iostream>
+
+#include "DataFormats/Common/interface/Handle.h"
+#include "DataFormats/HepMCCandidate/interface/GenParticle.h"
+#include "FWCore/Framework/interface/MakerMacros.h"
+#include "FWCore/Utilities/interface/Exception.h"
+
+#include "LHAPDF/LHAPDF.h"
+#include "TFile.h"
+#include "TH1D.h"
+
+
+PdfAcceptance::PdfAcceptance(const edm::ParameterSet& ps):
+  sums_(0)
+{
+  pdfSet_ = ps.getUntrackedParameter<std::string>("pdfSet", "cteq66");
+  pdfs_ = LHAPDF::mkPDFs(pdfSet_);
+  if (pdfs_.size() < 3 || pdfs_.size() % 2 == 0)
+    throw cms::Exception("Configuration")
+      << "PdfAcceptance: " << pdfSet_ << " has " << pdfs_.size()
+      << " members, a Hessian set (central + pairs) is needed\n";
+  sums_ = PdfAcceptanceSums(pdfs_.size());
+  hessianScale_ = ps.getUntrackedParameter<double>("hessianScale", 1.);
+  outputFile_ = ps.getUntrackedParameter<std::string>("outputfile", "pdfAcceptance.root");
+  genEventInfoToken_ = consumes<GenEventInfoProduct>
+    (ps.getUntrackedParameter<edm::InputTag>("genEventInfo", edm::InputTag("generator")));
+  MCToken_ = consumes<reco::GenParticleCollection>
+    (ps.getUntrackedParameter<edm::InputTag>("MCCollection", edm::InputTag("genParticles")));
+  motherId_ = ps.getUntrackedParameter<int>("motherId", 24);
+  minEt_ = ps.getUntrackedParameter<double>("minEt", 25.);
+  BarrelMaxEta = ps.getUntrackedParameter<double>("BarrelMaxEta", 1.4442);
+  EndcapMinEta = ps.getUntrackedParameter<double>("EndcapMinEta", 1.566);
+  EndcapMaxEta = ps.getUntrackedParameter<double>("EndcapMaxEta", 2.5);
+}
+
+PdfAcceptance::~PdfAcceptance()
+{
+  for (unsigned int k=0; k<pdfs_.size(); ++k) delete pdfs_[k];
+}
+
+std::unique_ptr<PdfAcceptanceSums>
+PdfAcceptance::beginStream(edm::StreamID) const
+{
+  return std::unique_ptr<PdfAcceptanceSums>(new PdfAcceptanceSums(pdfs_.size()));
+}
+
+void
+PdfAcceptance::analyze(edm::StreamID sid, const edm::Event& evt,
+		       const edm::EventSetup&) const
+{
+  PdfAcceptanceSums& s = *streamCache(sid);
+  edm::Handle<GenEventInfoProduct> info;
+  evt.getByToken(genEventInfoToken_, info);
+  edm::Handle<reco::GenParticleCollection> genParticles;
+  evt.getByToken(MCToken_, genParticles);
+  if (not info.isValid() || not info->hasPDF() || not genParticles.isValid()) {
+    ++s.skipped;
+    return;
+  }
+  bool counted;
+  const bool pass = accepted(*genParticles, counted);
+  if (not counted) return;
+  //
+  // the xf of both partons for all the members, then the weights
+  const GenEventInfoProduct::PDF *pdf = info->pdf();
+  // LHAPDF6 wants 21 for the gluon
+  const int id1 = pdf->id.first == 0 ? 21 : pdf->id.first;
+  const int id2 = pdf->id.second == 0 ? 21 : pdf->id.second;
+  const double x1 = pdf->x.first, x2 = pdf->x.second, Q = pdf->scalePDF;
+  const int n = pdfs_.size();
+  for (int k=0; k<n; ++k) {
+    s.f1[k] = pdfs_[k]->xfxQ(id1, x1, Q);
+    s.f2[k] = pdfs_[k]->xfxQ(id2, x2, Q);
+  }
+  pdfWeightBatch(n, &s.f1[0], &s.f2[0], &s.w[0]);
+  pdfAccumulate(n, &s.w[0], info->weight(), pass, &s.total[0], &s.pass[0]);
+  ++s.events;
+}
+
+// the highest ET status 1 electron of the mother; counted false if none
+bool
+PdfAcceptance::accepted(const reco::GenParticleCollection& genParticles,
+			bool& counted) const
+{
+  GenElectronMatcher electrons(0., 0.);
+  electrons.setEvent(genParticles);
+  int best = -1;
+  for (unsigned int i=0; i<electrons.size(); ++i) {
+    if (std::abs(electrons.motherId(i)) != motherId_) continue;
+    if (best < 0 || electrons.electron(i).et() > electrons.electron(best).et())
+      best = i;
+  }
+  counted = best >= 0;
+  if (not counted) return false;
+  const reco::GenParticle& ele = electrons.electron(best);
+  const double absEta = std::fabs(ele.eta());
+  const bool fiducial = absEta < BarrelMaxEta ||
+    (absEta > EndcapMinEta && absEta < EndcapMaxEta);
+  return fiducial && ele.et() > minEt_;
+}
+
+void
+PdfAcceptance::endStream(edm::StreamID sid) const
+{
+  const PdfAcceptanceSums& s = *streamCache(sid);
+  std::lock_guard<std::mutex> lock(mutex_);
+  sums_.events += s.events;
+  sums_.skipped += s.skipped;
+  for (unsigned int k=0; k<s.total.size(); ++k) {
+    sums_.total[k] += s.total[k];
+    sums_.pass[k] += s.pass[k];
+  }
+}
+
+void
+PdfAcceptance::endJob()
+{
+  const int n = pdfs_.size();
+  std::vector<double> acceptance(n, 0.);
+  for (int k=0; k<n; ++k)
+    if (sums_.total[k] > 0.) acceptance[k] = sums_.pass[k]/sums_.total[k];
+  double up, down;
+  hessianUncertainty(n, &acceptance[0], up, down);
+  up /= hessianScale_;  down /= hessianScale_;
+  //
+  std::cout << "PdfAcceptance: " << pdfSet_ << ", " << n << " members, "
+	    << sums_.events << " events";
+  if (sums_.skipped > 0) std::cout << " (" << sums_.skipped << " without PDF info)";
+  std::cout << std::endl;
+  char line[200];
+  snprintf(line, sizeof(line), "  acceptance = %.5f +%.5f -%.5f", acceptance[0], up, down);
+  std::cout << line << std::endl;
+  //
+  // the histograms belong to the file
+  TFile file(outputFile_.c_str(), "RECREATE");
+  TH1D *hTotal = new TH1D("pdf_total", "sum of weights, bin k+1: member k",
+			  n, -0.5, n-0.5);
+  TH1D *hPass = new TH1D("pdf_accepted", "accepted sum of weights, bin k+1: member k",
+			 n, -0.5, n-0.5);
+  TH1D *hAcc = new TH1D("pdf_acceptance", "acceptance, bin k+1: member k",
+			n, -0.5, n-0.5);
+  for (int k=0; k<n; ++k) {
+    hTotal->SetBinContent(k+1, sums_.total[k]);
+    hPass->SetBinContent(k+1, sums_.pass[k]);
+    hAcc->SetBinContent(k+1, acceptance[k]);
+  }
+  TH1D *hHessian = new TH1D("pdf_acceptance_hessian", "acceptance: central, +, -",
+			    3, -0.5, 2.5);
+  hHessian->SetBinContent(1, acceptance[0]);
+  hHessian->SetBinContent(2, up);
+  hHessian->SetBinContent(3, down);
+  file.Write();
+  file.Close();
+}
+
+//define this as a plug-in
+DEFINE_FWK_MODULE(PdfAcceptance);
@@ -0,0 +1,145 @@
+#include "ElectroWeakAnalysis/WENu/interface/SimpleEleIdMultiProducer.h"
+
+#include <cmath>
+#include <algorithm>
+
+#include "DataFormats/Common/interface/Handle.h"
+#include "DataFormats/Common/interface/ValueMap.h"
+#include "DataFormats/TrackReco/interface/HitPattern.h"
+#include "FWCore/Framework/interface/MakerMacros.h"
+#include "FWCore/Utilities/interface/Exception.h"
+
+
+SimpleEleIdMultiProducer::SimpleEleIdMultiProducer(const edm::ParameterSet& ps)
+{
+  electronToken_ = consumes<reco::GsfElectronCollection>(ps.getParameter<edm::InputTag>("src"));
+  // the same parameter name as EleIdCutBasedExtProducer: it is the beam spot
+  beamSpotToken_ = consumes<reco::BeamSpot>(ps.getParameter<edm::InputTag>("verticesCollection"));
+  //
+  // one threshold table per quality: robust<quality>EleIDCutsV04
+  const std::string prefix = ps.getParameter<std::string>("instancePrefix");
+  const std::vector<std::string> qualities =
+    ps.getParameter<std::vector<std::string> >("electronQualities");
+  for (unsigned int q=0; q<qualities.size(); ++q) {
+    const edm::ParameterSet& cuts =
+      ps.getParameter<edm::ParameterSet>("robust" + qualities[q] + "EleIDCutsV04");
+    SimpleEleIdWorkingPoint wp;
+    wp.label = prefix + qualities[q];
+    const char *region[2] = {"barrel", "endcap"};
+    for (int r=0; r<2; ++r) {
+      const std::vector<double> cut = cuts.getParameter<std::vector<double> >(region[r]);
+      if (cut.size() != SimpleEleIdWorkingPoint::NCUTS)
+	throw cms::Exception("Configuration")
+	  << "SimpleEleIdMultiProducer: " << region[r] << " of " << qualities[q]
+	  << " has " << cut.size() << " cuts, " << int(SimpleEleIdWorkingPoint::NCUTS)
+	  << " expected (V04)\n";
+      std::copy(cut.begin(), cut.end(), wp.cut[r]);
+    }
+    workingPoints_.push_back(wp);
+    produces<edm::ValueMap<float> >(wp.label);
+  }
+}
+
+SimpleEleIdMultiProducer::~SimpleEleIdMultiProducer()
+{
+}
+
+void
+SimpleEleIdMultiProducer::produce(edm::StreamID, edm::Event& evt,
+				  const edm::EventSetup&) const
+{
+  edm::Handle<reco::GsfElectronCollection> electrons;
+  evt.getByToken(electronToken_, electrons);
+  edm::Handle<reco::BeamSpot> pBeamSpot;
+  evt.getByToken(beamSpotToken_, pBeamSpot);
+  const reco::BeamSpot *beamSpot = pBeamSpot.isValid() ? pBeamSpot.product() : 0;
+  //
+  // the variables once, then all the working points
+  const unsigned int nEle = electrons->size();
+  const unsigned int nWP = workingPoints_.size();
+  std::vector<std::vector<float> > values(nWP, std::vector<float>(nEle, 0.));
+  SimpleEleIdVariables v;
+  for (unsigned int i=0; i<nEle; ++i) {
+    computeVariables((*electrons)[i], beamSpot, v);
+    for (unsigned int w=0; w<nWP; ++w) values[w][i] = workingPoints_[w].evaluate(v);
+  }
+  for (unsigned int w=0; w<nWP; ++w) {
+    std::unique_ptr<edm::ValueMap<float> > map(new edm::ValueMap<float>());
+    edm::ValueMap<float>::Filler filler(*map);
+    filler.insert(electrons, values[w].begin(), values[w].end());
+    filler.fill();
+    evt.put(std::move(map), workingPoints_[w].label);
+  }
+}
+
+//
+// as CutBasedElectronID::robustSelection, version V04
+void
+SimpleEleIdMultiProducer::computeVariables(const reco::GsfElectron& ele,
+					   const reco::BeamSpot *beamSpot,
+					   SimpleEleIdVariables& v)
+{
+  v.isEB = ele.isEB();
+  v.pt = ele.p4().Pt();
+  v.hOverE = ele.hadronicOverEm();
+  v.sigmaee = ele.sigmaIetaIeta();
+  v.deltaPhiIn = ele.deltaPhiSuperClusterTrackAtVtx();
+  v.deltaEtaIn = ele.deltaEtaSuperClusterTrackAtVtx();
+  v.e25Maxoe55 = ele.e2x5Max()/ele.e5x5();
+  v.e15oe55 = ele.e1x5()/ele.e5x5();
+  v.eOverP = ele.eSuperClusterOverP();
+  //
+  v.tkIso = ele.dr03TkSumPt();
+  v.ecalIso = ele.dr03EcalRecHitSumEt();
+  v.ecalIsoPed = v.isEB ? std::max(0., v.ecalIso-1.) : v.ecalIso;
+  v.hcalIso = ele.dr03HcalTowerSumEt();
+  v.hcalIso1 = ele.dr03HcalDepth1TowerSumEt();
+  v.hcalIso2 = ele.dr03HcalDepth2TowerSumEt();
+  //
+  v.ip = beamSpot ? std::fabs(ele.gsfTrack()->dxy(beamSpot->position()))
+    : std::fabs(ele.gsfTrack()->dxy());
+  v.mishits = ele.gsfTrack()->trackerExpectedHitsInner().numberOfHits();
+  v.firstPXBHit = ele.gsfTrack()->hitPattern().hasValidHitInFirstPixelBarrel();
+  v.dist = std::fabs(ele.convDist());
+  v.dcot = std::fabs(ele.convDcot());
+}
+
+float
+SimpleEleIdWorkingPoint::evaluate(const SimpleEleIdVariables& v) const
+{
+  const double *c = cut[v.isEB ? 0 : 1];
+  const double isoSum = v.tkIso + v.ecalIso + v.hcalIso;
+  const double isoSumPed = v.tkIso + v.ecalIsoPed + v.hcalIso;
+  float result = 0.;
+  //
+  // isolation
+  if (!(v.tkIso > c[6] || v.ecalIso > c[7] || v.hcalIso > c[8] ||
+	v.hcalIso1 > c[9] || v.hcalIso2 > c[10] ||
+	v.tkIso/v.pt > c[11] || v.ecalIso/v.pt > c[12] || v.hcalIso/v.pt > c[13] ||
+	isoSum > c[14] || isoSum/v.pt > c[15] ||
+	isoSumPed > c[16] || isoSumPed/v.pt > c[17]))
+    result = 2.;
+  //
+  // ID
+  if (v.hOverE > c[0]) return result;
+  if (v.sigmaee > c[1]) return result;
+  if (std::fabs(v.deltaPhiIn) > c[2]) return result;
+  if (std::fabs(v.deltaEtaIn) > c[3]) return result;
+  if (v.e25Maxoe55 < c[4] && v.e15oe55 < c[5]) return result;
+  if (v.sigmaee < c[18]) return result;
+  if (v.eOverP < c[19] || v.eOverP > c[20]) return result;
+  result += 1.;
+  //
+  // conversion rejection
+  if (v.ip > c[21]) return result;
+  if (v.mishits > c[22]) return result;
+  if (c[23] > 0 && !v.firstPXBHit) return result;
+  const bool isConversion = (c[24] > 99. || c[25] > 99.) ? false :
+    (v.dist < c[24] && v.dcot < c[25]);
+  if (isConversion) return result;
+  result += 4.;
+  return result;
+}
+
+//define this as a plug-in
+DEFINE_FWK_MODULE(SimpleEleIdMultiProducer);
@@ -39,6 +39,32 @@
            change to framework independent variable definitions 
 	   double->Double_t etc and math.h functions from TMath
   01Jul10  second electron information added
+  19Oct26  electron variables from the ElectronFeatureProducer maps
+           (electronFeatures), computed here if they are not given
+  19Oct26  ET and the calo/pf/tc MT in one WenuKinematics call, the
+           sin/cos of the electron phi once per event
+  19Oct26  energy scale and MET systematic variations in the same job
+           (systematicVariations), h_met/h_mt per variation
+  19Oct26  cut flow counters and stage timers (CutFlowMonitor), compiled
+           in with WENU_CUTFLOW, summary and cutFlowFile at endJob
+  19Oct26  event loop messages through WenuDiagnostics (WENU_DIAG_LEVEL,
+           diagnosticsEvery, diagnosticsLimit); the commented out electron
+           ID printout is the dump of debugEvents in debugDumpFile
+  19Oct26  the cut based selection is a WenuSelector<PatElectronAccessor>,
+           the same code as for the tuples (WenuSelector.h)
+  19Oct26  fixedSelection: a Spring10 working point with compile time
+           cuts (WenuFixedSelector), crossCheckFixedSelection compares it
+           with the runtime cuts
+  19Oct26  electron IDs and userInts by keys resolved once (PatElectronKeys),
+           usePrecalcIDSign parsed once into an ElectronIDCut
+  19Oct26  snapshotPort: copies of the histograms and cut flow counters,
+           every snapshotEvery events, on http://localhost:snapshotPort/
+           (HistogramSnapshotServer)
+  19Oct26  ele_passes_preselection, ele_passes_cuts in the tuples, the
+           preselection and the cuts of h_met
+  19Oct26  the systematic variations select with the cuts of CheckCuts
+           (also fixedSelection), the E/p cut scales with the energy
+  19Oct26  fixedSelection must have the cuts of the configuration
   Contact: 
   Nikolaos Rompotis  -  Nikolaos.Rompotis@Cern.ch
   Imperial College London
@@ -50,12 +76,18 @@
 
 
 #include "ElectroWeakAnalysis/WENu/interface/WenuPlots.h"
+#include "ElectroWeakAnalysis/WENu/interface/WenuKinematics.h"
 #include "DataFormats/Math/interface/deltaR.h"
 #include "DataFormats/JetReco/interface/PFJet.h"
 #include "DataFormats/JetReco/interface/CaloJet.h"
 #include "DataFormats/JetReco/interface/PFJetCollection.h"
 #include "DataFormats/JetReco/interface/CaloJetCollection.h"
 #include "DataFormats/VertexReco/interface/Vertex.h"
+#include "DataFormats/Provenance/interface/EventID.h"
+#include "FWCore/Utilities/interface/Exception.h"
+#include <sstream>
+#include <ctime>
+#include <limits>
 //#include "RecoEcal/EgammaCoreTools/plugins/EcalClusterCrackCorrectionFunctor.h"
 
 WenuPlots::WenuPlots(const edm::ParameterSet& iConfig)
@@ -72,6 +104,64 @@ WenuPlots::WenuPlots(const edm::ParameterSet& iConfig)
   wenuCollectionTag_ = iConfig.getUntrackedParameter<edm::InputTag>
     ("wenuCollectionTag");
   //
+  // the electron variables: the maps of an ElectronFeatureProducer,
+  // if not given they are computed here
+  features_.reset(new ElectronFeatureReader
+    (iConfig.getUntrackedParameter<edm::InputTag>("electronFeatures", edm::InputTag()),
+     iConfig.getUntrackedParameter<edm::InputTag>("beamSpotTag", edm::InputTag("offlineBeamSpot")),
+     consumesCollector()));
+  //
+  // the systematic variations: h_met_<name>, h_mt_<name> etc. for each
+  systematics_.reset(new WenuSystematics
+    (iConfig.getUntrackedParameter<std::vector<edm::ParameterSet> >
+     ("systematicVariations", std::vector<edm::ParameterSet>())));
+  //
+  // the cut flow: candidates, preselection, cumulative CutVars_, the
+  // selection, the inverted selection and the trackIso N-1
+  std::vector<std::string> counters;
+  counters.push_back("candidates");
+  counters.push_back("preselection");
+  for (int i=0; i<NCUTFLOWVARS; ++i)
+    counters.push_back(std::string("cut ") + WenuSelectorVars::name(i));
+  counters.push_back("selected");
+  counters.push_back("inverted selection");
+  counters.push_back("trackIso N-1");
+  std::vector<std::string> timers;
+  timers.push_back("collection fetch");
+  timers.push_back("feature extraction");
+  timers.push_back("tuple variables and fill");
+  timers.push_back("jet block");
+  timers.push_back("selection");
+  timers.push_back("histogram fill");
+  cutFlow_.reset(new CutFlowMonitor(counters, timers));
+  cutFlowFile_ = iConfig.getUntrackedParameter<std::string>("cutFlowFile", "WenuPlots_cutflow.txt");
+  //
+  // event loop messages: one in diagnosticsEvery is printed, at most
+  // diagnosticsLimit times each (0: no limit)
+  const unsigned int diagEvery =
+    iConfig.getUntrackedParameter<unsigned int>("diagnosticsEvery", 1);
+  const unsigned int diagLimit =
+    iConfig.getUntrackedParameter<unsigned int>("diagnosticsLimit", 10);
+  diag_.reset(new WenuDiagnostics("WenuPlots"));
+  msgNoCands_       = diag_->add("no wenu candidates", diagEvery, diagLimit);
+  msgNoCaloJets_    = diag_->add("no caloJet collection", diagEvery, diagLimit);
+  msgNoPfJets_      = diag_->add("no pfJet collection", diagEvery, diagLimit);
+  msgNoConvRej_     = diag_->add("conversion rejection not calculated", diagEvery, diagLimit);
+  msgNoPXB_         = diag_->add("valid first PXB hit not calculated", diagEvery, diagLimit);
+  msgNoMissingHits_ = diag_->add("expected missing hits not calculated", diagEvery, diagLimit);
+  msgIsolation_     = diag_->add("isolation of the selected electron", diagEvery, diagLimit);
+  //
+  // the full information of these (run, event) in debugDumpFile
+  const std::vector<edm::EventID> debugEvents =
+    iConfig.getUntrackedParameter<std::vector<edm::EventID> >
+    ("debugEvents", std::vector<edm::EventID>());
+  std::vector<std::pair<unsigned int, unsigned long long> > dumpEvents;
+  for (unsigned int i=0; i<debugEvents.size(); ++i)
+    dumpEvents.push_back(std::make_pair(debugEvents[i].run(),
+					(unsigned long long) debugEvents[i].event()));
+  debugDump_.reset(new WenuDebugDump(dumpEvents, iConfig.getUntrackedParameter<std::string>
+				     ("debugDumpFile", "WenuPlots_debug.txt")));
+  //
   // code parameters
   //
   std::string outputFile_D = "histos.root";
@@ -87,12 +177,52 @@ WenuPlots::WenuPlots(const edm::ParameterSet& iConfig)
     usePrecalcIDType_ = iConfig.getUntrackedParameter<std::string>("usePrecalcIDType");    
     usePrecalcIDSign_ = iConfig.getUntrackedParameter<std::string>("usePrecalcIDSign","=");    
     usePrecalcIDValue_= iConfig.getUntrackedParameter<Double_t>("usePrecalcIDValue");
+    precalcID_ = ElectronIDKey(usePrecalcIDType_);
+    precalcIDCut_ = ElectronIDCut(usePrecalcIDSign_, usePrecalcIDValue_);
   }
+  // the electron IDs of the second electron, WP95 to WP60
+  const char *ele2ndIDs[NELE2NDIDS] = {"simpleEleId95relIso", "simpleEleId90relIso",
+				       "simpleEleId85relIso", "simpleEleId80relIso",
+				       "simpleEleId70relIso", "simpleEleId60relIso"};
+  for (int i=0; i<NELE2NDIDS; ++i) ele2ndIDs_[i] = ElectronIDKey(ele2ndIDs[i]);
+  // the userInts of the WenuCandidateFilter
+  passConversionRejection_ = UserIntKey("PassConversionRejection");
+  passValidFirstPXBHit_ = UserIntKey("PassValidFirstPXBHit");
+  numberOfExpectedMissingHits_ = UserIntKey("NumberOfExpectedMissingHits");
+  hasSecondElectron_ = UserIntKey("hasSecondElectron");
+  failsSecondElectronCut_ = UserIntKey("failsSecondElectronCut");
+  triggerDecision_ = UserIntKey("triggerDecision");
   useValidFirstPXBHit_ = iConfig.getUntrackedParameter<Bool_t>("useValidFirstPXBHit",false);
   useConversionRejection_ = iConfig.getUntrackedParameter<Bool_t>("useConversionRejection",false);
   useExpectedMissingHits_ = iConfig.getUntrackedParameter<Bool_t>("useExpectedMissingHits",false);
 
   maxNumberOfExpectedMissingHits_ = iConfig.getUntrackedParameter<Int_t>("maxNumberOfExpectedMissingHits",1);
+  //
+  // a working point of Spring10WorkingPoints.h instead of the cuts of the
+  // configuration, for CheckCuts (the inverse and N-1 plots keep these)
+  fixedSelectionName_ = iConfig.getUntrackedParameter<std::string>("fixedSelection", "");
+  fixedSelection_ = 0;
+  if (fixedSelectionName_ != "" && not usePrecalcID_) {
+    fixedSelection_ = spring10Selection<PatElectronAccessor>(fixedSelectionName_);
+    if (fixedSelection_ == 0)
+      throw cms::Exception("Configuration")
+	<< "WenuPlots: no working point " << fixedSelectionName_
+	<< " in Spring10WorkingPoints.h\n";
+  }
+  crossCheckFixedSelection_ =
+    iConfig.getUntrackedParameter<Bool_t>("crossCheckFixedSelection", false);
+  crossCheckElectrons_ = 0;
+  crossCheckDifferences_ = 0;
+  msgFixedMismatch_ = diag_->add("fixed and runtime selection differ", diagEvery, diagLimit);
+  //
+  // live snapshots for long jobs: port 0 no server
+  snapshotPort_ = iConfig.getUntrackedParameter<Int_t>("snapshotPort", 0);
+  snapshotEvery_ = iConfig.getUntrackedParameter<Int_t>("snapshotEvery", 10000);
+  if (snapshotPort_ < 0 || snapshotPort_ > 65535 || snapshotEvery_ <= 0)
+    throw cms::Exception("Configuration")
+      << "WenuPlots: snapshotPort " << snapshotPort_ << " must be 0..65535 and snapshotEvery "
+      << snapshotEvery_ << " positive\n";
+  snapshotEvents_ = 0;
   if (not usePrecalcID_) {
     if (useValidFirstPXBHit_) std::cout << "WenuPlots: Warning: you have demanded a valid 1st layer PXB hit" << std::endl;
     if (useConversionRejection_) std::cout << "WenuPlots: Warning: you have demanded egamma conversion rejection criteria to be applied" << std::endl;
@@ -192,6 +322,9 @@ WenuPlots::~WenuPlots()
  
    // do anything here that needs to be done at desctruction time
    // (e.g. close files, deallocate resources etc.)
+  // the snapshot server thread first; the other members (unique_ptr)
+  // go in the reverse order of their declaration
+  snapshotServer_.reset();
 
 }
 
@@ -205,6 +338,13 @@ void
 WenuPlots::analyze(const edm::Event& iEvent, const edm::EventSetup& es)
 {
   using namespace std;
+  // the stage timers: each stage runs until the next one starts
+  CutFlowMonitor::Timer timer(*cutFlow_, T_FETCH);
+  // the histograms of the events before this one
+  if (snapshotServer_) {
+    if (snapshotEvents_ > 0 && snapshotEvents_ % snapshotEvery_ == 0) PublishSnapshot();
+    ++snapshotEvents_;
+  }
   //
   //  Get the collections here
   //
@@ -212,9 +352,11 @@ WenuPlots::analyze(const edm::Event& iEvent, const edm::EventSetup& es)
   iEvent.getByLabel(wenuCollectionTag_, WenuCands);
 
   if (not WenuCands.isValid()) {
-    cout << "Warning: no wenu candidates in this event..." << endl;
+    WENU_DIAG(*diag_, WENU_DIAG_WARNING, msgNoCands_,
+	      "Warning: no wenu candidates in this event...");
     return;
   }
+  cutFlow_->count(CF_CANDIDATES);
   const pat::CompositeCandidateCollection *wcands = WenuCands.product();
   const pat::CompositeCandidateCollection::const_iterator 
     wenuIter = wcands->begin();
@@ -229,6 +371,26 @@ WenuPlots::analyze(const edm::Event& iEvent, const edm::EventSetup& es)
     dynamic_cast<const pat::MET*> (wenu.daughter("pfmet"));
   const pat::MET * myTcMet=
     dynamic_cast<const pat::MET*> (wenu.daughter("tcmet"));
+  //
+  // the electron variables of this event
+  timer.next(T_FEATURES);
+  features_->getMaps(iEvent, featureMaps_);
+  selector_->accessor().setEvent(features_.get(), &featureMaps_);
+  const float *feat = Features(myElec);
+  //
+  // ET and MT of the electron with the 3 MET in one go: ET with the gsf
+  // track eta for the tuples, with the SC eta for the histograms
+  WenuKinematics<2, 3> kin;
+  const Double_t scEnergy = myElec->superCluster()->energy();
+  const int eleTuple =
+    kin.addElectron(transverseEnergy(scEnergy, myElec->gsfTrack()->eta()),
+		    myElec->superCluster()->phi());
+  const int eleHisto =
+    kin.addElectronAlong(eleTuple, transverseEnergy(scEnergy, myElec->superCluster()->eta()));
+  const int caloMet = kin.addMet(myMet->et(), myMet->phi());
+  const int pfMet = kin.addMet(myPfMet->et(), myPfMet->phi());
+  const int tcMet = kin.addMet(myTcMet->et(), myTcMet->phi());
+  kin.compute();
   // _______________________________________________________________________
   //
   // VBTF Root tuple production --------------------------------------------
@@ -241,6 +403,7 @@ WenuPlots::analyze(const edm::Event& iEvent, const edm::EventSetup& es)
   // .......................................................................
   //
   // fill the tree variables
+  timer.next(T_TUPLE);
   runNumber   = iEvent.run();
   eventNumber = Long64_t( iEvent.eventAuxiliary().event() );
   lumiSection = (Int_t) iEvent.luminosityBlock();
@@ -252,20 +415,19 @@ WenuPlots::analyze(const edm::Event& iEvent, const edm::EventSetup& es)
   double scz = myElec->superCluster()->z();
   ele_sc_rho       = (Float_t)  sqrt( scx*scx + scy*scy + scz*scz );
   ele_sc_energy    = (Float_t)  myElec->superCluster()->energy();
-  ele_sc_gsf_et    = (Float_t)  myElec->superCluster()->energy()/TMath::CosH(myElec->gsfTrack()->eta());
+  ele_sc_gsf_et    = (Float_t)  kin.et(eleTuple);
   ele_cand_eta     = (Float_t)  myElec->eta();
   ele_cand_phi     = (Float_t)  myElec->phi();
   ele_cand_et      = (Float_t)  myElec->et();
   //
-  ele_iso_track    = (Float_t)  myElec->dr03IsolationVariables().tkSumPt / ele_cand_et;
-  ele_iso_ecal     = (Float_t)  myElec->dr03IsolationVariables().ecalRecHitSumEt/ele_cand_et;
-  ele_iso_hcal     = (Float_t)  ( myElec->dr03IsolationVariables().hcalDepth1TowerSumEt +
-       myElec->dr03IsolationVariables().hcalDepth2TowerSumEt) / ele_cand_et;
+  ele_iso_track    = (Float_t)  feat[ElectronFeatures::TRACK_ISO03] / ele_cand_et;
+  ele_iso_ecal     = (Float_t)  feat[ElectronFeatures::ECAL_ISO03] / ele_cand_et;
+  ele_iso_hcal     = (Float_t)  feat[ElectronFeatures::HCAL_ISO03] / ele_cand_et;
   //
-  ele_id_sihih     = (Float_t)  myElec->sigmaIetaIeta();
-  ele_id_deta      = (Float_t)  myElec->deltaEtaSuperClusterTrackAtVtx();
-  ele_id_dphi      = (Float_t)  myElec->deltaPhiSuperClusterTrackAtVtx();
-  ele_id_hoe       = (Float_t)  myElec->hadronicOverEm();
+  ele_id_sihih     = (Float_t)  feat[ElectronFeatures::SIHIH];
+  ele_id_deta      = (Float_t)  feat[ElectronFeatures::DETA_IN];
+  ele_id_dphi      = (Float_t)  feat[ElectronFeatures::DPHI_IN];
+  ele_id_hoe       = (Float_t)  feat[ElectronFeatures::HOE];
   //
   ele_cr_mhitsinner= myElec->gsfTrack()->trackerExpectedHitsInner().numberOfHits();
   ele_cr_dcot      = myElec->convDcot();
@@ -311,11 +473,11 @@ WenuPlots::analyze(const edm::Event& iEvent, const edm::EventSetup& es)
   // must keep the ctf track collection, i.e. general track collection
   ele_ctfCharge    = (Int_t) myElec->closestCtfTrackRef().isNonnull() ? myElec->closestCtfTrackRef()->charge():-9999;
   ele_scPixCharge  = (Int_t) myElec->chargeInfo().scPixCharge;
-  ele_eop          = (Float_t) myElec->eSuperClusterOverP();
+  ele_eop          = (Float_t) feat[ElectronFeatures::EOP];
   ele_tip_bs       = (Float_t) -myElec->dB();
   //ele_tip_pv       = myElec->userFloat("ele_tip_pv");
-  ele_pin          = (Float_t)  myElec->trackMomentumAtVtx().R();
-  ele_pout         = (Float_t)  myElec->trackMomentumOut().R();
+  ele_pin          = (Float_t)  feat[ElectronFeatures::PIN];
+  ele_pout         = (Float_t)  feat[ElectronFeatures::POUT];
   //
   event_caloMET    = (Float_t) myMet->et();
   event_pfMET      = (Float_t) myPfMet->et();
@@ -327,22 +489,14 @@ WenuPlots::analyze(const edm::Event& iEvent, const edm::EventSetup& es)
   event_pfSumEt  = (Float_t) myPfMet->sumEt();
   event_tcSumEt  = (Float_t) myTcMet->sumEt();
   // transverse mass for the user's convenience
-  event_caloMT     = (Float_t) TMath::Sqrt(2.*(ele_sc_gsf_et*event_caloMET -
-    (ele_sc_gsf_et*TMath::Cos(ele_sc_phi)*event_caloMET*TMath::Cos(event_caloMET_phi)
-     + ele_sc_gsf_et*TMath::Sin(ele_sc_phi)*event_caloMET*TMath::Sin(event_caloMET_phi)
-     ) )  );
-  event_pfMT       = (Float_t) TMath::Sqrt(2.*(ele_sc_gsf_et*event_pfMET -
-    (ele_sc_gsf_et*TMath::Cos(ele_sc_phi)*event_pfMET*TMath::Cos(event_pfMET_phi)
-     + ele_sc_gsf_et*TMath::Sin(ele_sc_phi)*event_pfMET*TMath::Sin(event_pfMET_phi)
-     ) )  );
-  event_tcMT       = (Float_t) TMath::Sqrt(2.*(ele_sc_gsf_et*event_tcMET -
-    (ele_sc_gsf_et*TMath::Cos(ele_sc_phi)*event_tcMET*TMath::Cos(event_tcMET_phi)
-     + ele_sc_gsf_et*TMath::Sin(ele_sc_phi)*event_tcMET*TMath::Sin(event_tcMET_phi)
-     ) )  );
+  event_caloMT     = (Float_t) kin.mt(eleTuple, caloMet);
+  event_pfMT       = (Float_t) kin.mt(eleTuple, pfMet);
+  event_tcMT       = (Float_t) kin.mt(eleTuple, tcMet);
   event_datasetTag = DatasetTag_;
   // jet information - only if the user asks for it
   // keep the 5 highest et jets of the event that are further than DR> DRJetFromElectron_
   if (includeJetInformationInNtuples_) {
+    timer.next(T_JETS);
     // initialize the array of the jet information
     for (int i=0; i<5; ++i) {
       calojet_et[i] = -999999;  calojet_eta[i] = -999999; calojet_phi[i] = -999999;
@@ -388,8 +542,8 @@ WenuPlots::analyze(const edm::Event& iEvent, const edm::EventSetup& es)
 	delete [] nCaloPhi;	
       }
     } else {
-      std::cout << "WenuPlots: Could not get caloJet collection with name " 
-		<< caloJetCollectionTag_ << std::endl;
+      WENU_DIAG(*diag_, WENU_DIAG_WARNING, msgNoCaloJets_,
+		"Could not get caloJet collection with name " << caloJetCollectionTag_);
     }
     //
     // pf jets now:
@@ -426,10 +580,10 @@ WenuPlots::analyze(const edm::Event& iEvent, const edm::EventSetup& es)
 	delete [] nPfPhi;	
       }
     } else {
-      std::cout << "WenuPlots: Could not get pfJet collection with name " 
-		<< pfJetCollectionTag_ << std::endl;
+      WENU_DIAG(*diag_, WENU_DIAG_WARNING, msgNoPfJets_,
+		"Could not get pfJet collection with name " << pfJetCollectionTag_);
     }
-
+    timer.next(T_TUPLE);
   }
   // second electron information - in preselected ntuple only
   ele2nd_sc_gsf_et = -1; // also in sele tree
@@ -480,10 +634,11 @@ WenuPlots::analyze(const edm::Event& iEvent, const edm::EventSetup& es)
   // 4 passes WP80
   // 5 passes WP70
   // 6 passes WP60
-  if (myElec->userInt("hasSecondElectron") == 1 && storeExtraInformation_) {
+  if (hasSecondElectron_.value(*myElec) == 1 && storeExtraInformation_) {
     const pat::Electron * mySecondElec=
       dynamic_cast<const pat::Electron*> (wenu.daughter("secondElec"));    
-    ele2nd_sc_gsf_et = (Float_t) mySecondElec->superCluster()->energy()/TMath::CosH(mySecondElec->gsfTrack()->eta());
+    ele2nd_sc_gsf_et = (Float_t) transverseEnergy(mySecondElec->superCluster()->energy(),
+						   mySecondElec->gsfTrack()->eta());
 
     ele2nd_sc_eta    = (Float_t) mySecondElec->superCluster()->eta();
     ele2nd_sc_phi    = (Float_t) mySecondElec->superCluster()->phi();
@@ -497,31 +652,29 @@ WenuPlots::analyze(const edm::Event& iEvent, const edm::EventSetup& es)
     ele2nd_pin       = (Float_t) mySecondElec->trackMomentumAtVtx().R();;
     ele2nd_pout      = (Float_t) mySecondElec->trackMomentumOut().R();
     ele2nd_ecalDriven= (Int_t)   mySecondElec->ecalDrivenSeed();
-    // check the selections
-    bool isIDCalc = mySecondElec->isElectronIDAvailable("simpleEleId95relIso") &&
-      mySecondElec->isElectronIDAvailable("simpleEleId90relIso") &&
-      mySecondElec->isElectronIDAvailable("simpleEleId85relIso") &&
-      mySecondElec->isElectronIDAvailable("simpleEleId80relIso") &&
-      mySecondElec->isElectronIDAvailable("simpleEleId70relIso") &&
-      mySecondElec->isElectronIDAvailable("simpleEleId60relIso");
+    // check the selections: the tightest working point that passes
+    bool isIDCalc = true;
+    for (int i=0; i<NELE2NDIDS; ++i)
+      isIDCalc = isIDCalc && ele2ndIDs_[i].available(*mySecondElec);
     if (isIDCalc) {
       ele2nd_passes_selection = 0;
-      if (fabs(mySecondElec->electronID("simpleEleId60relIso")-7) < 0.1) ele2nd_passes_selection = 6;
-      else if (fabs(mySecondElec->electronID("simpleEleId70relIso")-7) < 0.1) ele2nd_passes_selection = 5;
-      else if (fabs(mySecondElec->electronID("simpleEleId80relIso")-7) < 0.1) ele2nd_passes_selection = 4;
-      else if (fabs(mySecondElec->electronID("simpleEleId85relIso")-7) < 0.1) ele2nd_passes_selection = 3;
-      else if (fabs(mySecondElec->electronID("simpleEleId90relIso")-7) < 0.1) ele2nd_passes_selection = 2;
-      else if (fabs(mySecondElec->electronID("simpleEleId95relIso")-7) < 0.1) ele2nd_passes_selection = 1;
+      for (int i=NELE2NDIDS-1; i>=0; --i) {
+	if (fabs(ele2ndIDs_[i].value(*mySecondElec)-7) < 0.1) {
+	  ele2nd_passes_selection = i+1;
+	  break;
+	}
+      }
     }
     if (storeAllSecondElectronVariables_) {
-      ele2nd_iso_track = (Float_t)  mySecondElec->dr03IsolationVariables().tkSumPt / ele2nd_cand_et;
-      ele2nd_iso_ecal  = (Float_t)  mySecondElec->dr03IsolationVariables().ecalRecHitSumEt/ele2nd_cand_et;
-      ele2nd_iso_hcal  = (Float_t)  ( mySecondElec->dr03IsolationVariables().hcalDepth1TowerSumEt + 
-				      mySecondElec->dr03IsolationVariables().hcalDepth2TowerSumEt) / ele2nd_cand_et;
-      ele2nd_id_sihih  = (Float_t)  mySecondElec->sigmaIetaIeta();
-      ele2nd_id_deta   = (Float_t)  mySecondElec->deltaEtaSuperClusterTrackAtVtx();
-      ele2nd_id_dphi   = (Float_t)  mySecondElec->deltaPhiSuperClusterTrackAtVtx();
-      ele2nd_id_hoe    = (Float_t)  mySecondElec->hadronicOverEm();
+      float feat2[ElectronFeatures::NFEATURES];
+      features_->get(featureMaps_, *mySecondElec, feat2);
+      ele2nd_iso_track = (Float_t)  feat2[ElectronFeatures::TRACK_ISO03] / ele2nd_cand_et;
+      ele2nd_iso_ecal  = (Float_t)  feat2[ElectronFeatures::ECAL_ISO03] / ele2nd_cand_et;
+      ele2nd_iso_hcal  = (Float_t)  feat2[ElectronFeatures::HCAL_ISO03] / ele2nd_cand_et;
+      ele2nd_id_sihih  = (Float_t)  feat2[ElectronFeatures::SIHIH];
+      ele2nd_id_deta   = (Float_t)  feat2[ElectronFeatures::DETA_IN];
+      ele2nd_id_dphi   = (Float_t)  feat2[ElectronFeatures::DPHI_IN];
+      ele2nd_id_hoe    = (Float_t)  feat2[ElectronFeatures::HOE];
 
       ele2nd_cr_mhitsinner = mySecondElec->gsfTrack()->trackerExpectedHitsInner().numberOfHits();
       ele2nd_cr_dcot       = mySecondElec->convDcot();
@@ -534,7 +687,7 @@ WenuPlots::analyze(const edm::Event& iEvent, const edm::EventSetup& es)
       // must keep the ctf track collection, i.e. general track collection
       ele2nd_ctfCharge   = (Int_t) mySecondElec->closestCtfTrackRef().isNonnull() ? mySecondElec->closestCtfTrackRef()->charge():-9999;
       ele2nd_scPixCharge = (Int_t) mySecondElec->chargeInfo().scPixCharge;
-      ele2nd_eop         = (Float_t) mySecondElec->eSuperClusterOverP();
+      ele2nd_eop         = (Float_t) feat2[ElectronFeatures::EOP];
       ele2nd_tip_bs      = (Float_t) -mySecondElec->dB();
       if (Vtx.size() > 0) {
 	ele2nd_tip_pv      =   mySecondElec->gsfTrack()->dxy(Vtx[0].position());
@@ -556,8 +709,8 @@ WenuPlots::analyze(const edm::Event& iEvent, const edm::EventSetup& es)
     if (myElec->hasUserFloat("HLTMatchingDR")) {
       ele_hltmatched_dr = myElec->userFloat("HLTMatchingDR");
     }
-    if (myElec->hasUserInt("triggerDecision")) {
-      event_triggerDecision = myElec->userInt("triggerDecision");
+    if (triggerDecision_.available(*myElec)) {
+      event_triggerDecision = triggerDecision_.value(*myElec);
     }
     // extra information related to the primary vtx collection
     for (Int_t i=0; i < (Int_t) Vtx.size(); ++i) {
@@ -572,31 +725,40 @@ WenuPlots::analyze(const edm::Event& iEvent, const edm::EventSetup& es)
   // if the electron passes the selection
   // it is meant to be a precalculated selection here, in order to include
   // conversion rejection too
-  if (CheckCuts(myElec) && myElec->userInt("failsSecondElectronCut") == 0) {
+  // the preselection and the cuts of the histograms are in the tuples too,
+  // for an ABCD from the tuples with the regions of h_met (ABCDTuples.h)
+  const Bool_t passPreselection = usePreselection_ ? PassPreselectionCriteria(myElec) : true;
+  const Bool_t passSelection = CheckCuts(myElec);
+  ele_passes_preselection = passPreselection;
+  ele_passes_cuts = passSelection;
+  if (passSelection && failsSecondElectronCut_.value(*myElec) == 0) {
     vbtfSele_tree->Fill();
   }
   vbtfPresele_tree->Fill();
 
 
 
+  timer.next(T_SELECTION);
   //
   // _______________________________________________________________________
   //
   // histogram production --------------------------------------------------
   // _______________________________________________________________________
   //
+  // the events of debugEvents: everything about them, before any cut
+  if (debugDump_->wants(iEvent.run(), iEvent.id().event()))
+    DebugDump(iEvent, myElec);
+  //
   // if you want some preselection: Conv rejection, hit pattern 
-  if (usePreselection_) {
-    if (not PassPreselectionCriteria(myElec)) return;
-  }
+  if (not passPreselection) return;
+  cutFlow_->count(CF_PRESELECTION);
   //
   // some variables here
   Double_t scEta = myElec->superCluster()->eta();
   Double_t scPhi = myElec->superCluster()->phi();
-  Double_t scEt = myElec->superCluster()->energy()/TMath::CosH(scEta);
-  Double_t met    = myMet->et();
-  Double_t metPhi = myMet->phi();
-  Double_t mt  = TMath::Sqrt(2.0*scEt*met*(1.0-(TMath::Cos(scPhi)*TMath::Cos(metPhi)+TMath::Sin(scPhi)*TMath::Sin(metPhi))));
+  Double_t scEt  = kin.et(eleHisto);
+  Double_t met    = kin.met(caloMet);
+  Double_t mt     = kin.mt(eleHisto, caloMet);
 
   Double_t trackIso = myElec->userIsolation(pat::TrackIso);
   Double_t ecalIso = myElec->userIsolation(pat::EcalIso);
@@ -606,12 +768,11 @@ WenuPlots::analyze(const edm::Event& iEvent, const edm::EventSetup& es)
   Double_t deta = myElec->deltaEtaSuperClusterTrackAtVtx();
   Double_t HoE = myElec->hadronicOverEm();
   //
-  //
-  //
   // the inverted selection plots:
   // only if not using precalcID
   if (not usePrecalcID_) {
     if (CheckCutsInverse(myElec)){
+      cutFlow_->count(CF_INVERTED);
       //std::cout << "-----------------INVERSION-----------passed" << std::endl;
       h_met_inverse->Fill(met);
       h_mt_inverse->Fill(mt);
@@ -634,19 +795,36 @@ WenuPlots::analyze(const edm::Event& iEvent, const edm::EventSetup& es)
   if (not usePrecalcID_) {
     if ( TMath::Abs(scEta) < 1.479) { // reminder: the precise fiducial cuts are in
       // in the filter
-      if (CheckCutsNminusOne(myElec, 0)) 
+      if (CheckCutsNminusOne(myElec, 0)) {
 	h_trackIso_eb_NmOne->Fill(trackIso);
+	cutFlow_->count(CF_NMINUSONE);
+      }
     }
     else {
-      if (CheckCutsNminusOne(myElec, 0)) 
+      if (CheckCutsNminusOne(myElec, 0)) {
 	h_trackIso_ee_NmOne->Fill(trackIso);
+	cutFlow_->count(CF_NMINUSONE);
+      }
     }
   }
   //
+  // the cumulative cut flow, in the order of CutVars_
+  if (CutFlowMonitor::enabled && not usePrecalcID_) {
+    const int passed = selector_->firstFailed(*myElec);
+    for (int i=0; i<passed; ++i) cutFlow_->count(CF_CUTS + i);
+  }
+  if (passSelection) cutFlow_->count(CF_SELECTED);
+  timer.next(T_HISTOS);
+  //
+  // the systematic variations: selection, MET and MT of all of them at
+  // once, before the nominal selection that they may not share
+  if (systematics_->size() > 0)
+    FillSystematics(myElec, scEt, scEta, scPhi, met, myMet->phi(), passSelection);
+  //
   // SELECTION APPLICATION
   //
   // from here on you have only events that pass the full selection
-  if (not CheckCuts(myElec)) return;
+  if (not passSelection) return;
   //////////////////////////////////////////////////////////////////////
 
   h_met->Fill(met);
@@ -677,28 +855,12 @@ WenuPlots::analyze(const edm::Event& iEvent, const edm::EventSetup& es)
     h_EE_HoE->Fill( HoE );
 
   }
-  // uncomment for debugging purposes
-  /*
-  std::cout << "tracIso: " <<  trackIso << ", " << myElec->trackIso() << ", ecaliso: " << ecalIso 
-	    << ", " << myElec->ecalIso() << ", hcaliso: " << hcalIso << ", "  << myElec->hcalIso() 
-	    << ", mishits: " 
-	    << myElec->gsfTrack()->trackerExpectedHitsInner().numberOfHits()
-	    << std::endl;
-  std::cout << "Electron ID: 95relIso=" << myElec->electronID("simpleEleId95relIso")  
-	    << " 90relIso=" << myElec->electronID("simpleEleId90relIso") 
-	    << " 85relIso=" << myElec->electronID("simpleEleId85relIso") 
-	    << " 80relIso=" << myElec->electronID("simpleEleId80relIso") 
-	    << " 70relIso=" << myElec->electronID("simpleEleId70relIso") 
-	    << " 60relIso=" << myElec->electronID("simpleEleId60relIso") 
-	    << " 95cIso=" << myElec->electronID("simpleEleId95cIso") 
-	    << " 90cIso=" << myElec->electronID("simpleEleId90cIso") 
-	    << " 85cIso=" << myElec->electronID("simpleEleId85cIso") 
-	    << " 80cIso=" << myElec->electronID("simpleEleId80cIso") 
-	    << " 70cIso=" << myElec->electronID("simpleEleId70cIso") 
-	    << " 60cIso=" << myElec->electronID("simpleEleId60cIso") 
-	    << std::endl;
-  std::cout << "mySelection: " << (CheckCuts(myElec) && PassPreselectionCriteria(myElec)) << endl;
-  */
+  // debugging: the electron ID values are in the dump of debugEvents
+  WENU_DIAG(*diag_, WENU_DIAG_DEBUG, msgIsolation_,
+	    "tracIso: " <<  trackIso << ", " << myElec->trackIso() << ", ecaliso: " << ecalIso
+	    << ", " << myElec->ecalIso() << ", hcaliso: " << hcalIso << ", "  << myElec->hcalIso()
+	    << ", mishits: "
+	    << myElec->gsfTrack()->trackerExpectedHitsInner().numberOfHits());
   h_scEt->Fill(scEt);
   h_scEta->Fill(scEta);
   h_scPhi->Fill(scPhi);
@@ -723,97 +885,166 @@ WenuPlots::analyze(const edm::Event& iEvent, const edm::EventSetup& es)
 Bool_t WenuPlots::CheckCuts( const pat::Electron *ele)
 {
   if (usePrecalcID_) {
-    if (not ele-> isElectronIDAvailable(usePrecalcIDType_)) {
+    if (not precalcID_.available(*ele)) {
       std::cout << "Error! not existing ID with name: "
 		<< usePrecalcIDType_ << " function will return true!"
 		<< std::endl;
       return true;
     }
-    Double_t val = ele->electronID(usePrecalcIDType_);
-    if (usePrecalcIDSign_ == "<") {
-      return val < usePrecalcIDValue_;
-    }
-    else if (usePrecalcIDSign_ == ">") {
-      return val > usePrecalcIDValue_;
-    }
-    else { // equality: it returns 0,1,2,3 but as float
-      return TMath::Abs(val-usePrecalcIDValue_)<0.1;
-    }
+    // usePrecalcIDSign: <, > or equality (the IDs are floats)
+    return precalcIDCut_(precalcID_.value(*ele));
   } 
-  else {
-    for (int i=0; i<nBarrelVars_; ++i) {
-      if (not CheckCut(ele, i)) return false;
+  else if (fixedSelection_) {
+    const Bool_t pass = fixedSelection_(selector_->accessor(), *ele);
+    if (crossCheckFixedSelection_) {
+      ++crossCheckElectrons_;
+      if (pass != selector_->passesAll(*ele)) {
+	++crossCheckDifferences_;
+	WENU_DIAG(*diag_, WENU_DIAG_WARNING, msgFixedMismatch_,
+		  "fixed selection " << fixedSelectionName_ << ": " << pass
+		  << ", runtime cuts: " << not pass << ", sc eta "
+		  << ele->superCluster()->eta());
+      }
     }
-    return true;
+    return pass;
+  }
+  else {
+    return selector_->passesAll(*ele);
   }
 }
 /////////////////////////////////////////////////////////////////////////
 
 Bool_t WenuPlots::CheckCutsInverse(const pat::Electron *ele)
 {
-  for (int i=0; i<nBarrelVars_; ++i){
-    if ( CheckCutInv(ele, i) == false) return false;
-  }
-  return true;
-
+  return selector_->passesInverse(*ele);
 }
 /////////////////////////////////////////////////////////////////////////
 Bool_t WenuPlots::CheckCutsNminusOne(const pat::Electron *ele, int jj)
 {
-  for (int i=0; i<nBarrelVars_; ++i){
-    if (i==jj) continue;
-    if ( CheckCut(ele, i) == false) return false;
-  }
-  return true;
+  return selector_->passesNminusOne(*ele, jj);
 }
 /////////////////////////////////////////////////////////////////////////
 Bool_t WenuPlots::CheckCut(const pat::Electron *ele, int i) {
-  Double_t fabseta = TMath::Abs(ele->superCluster()->eta());
-  if ( fabseta<1.479) {
-    return TMath::Abs(ReturnCandVar(ele, i)) < CutVars_[i];
-  }
-  return TMath::Abs(ReturnCandVar(ele, i)) < CutVars_[i+nBarrelVars_];
+  return selector_->passes(*ele, i);
 }
 /////////////////////////////////////////////////////////////////////////
 Bool_t WenuPlots::CheckCutInv(const pat::Electron *ele, int i) {
-  Double_t fabseta = TMath::Abs(ele->superCluster()->eta());
-  if ( fabseta<1.479) {
-    if (InvVars_[i]) 
-    return TMath::Abs(ReturnCandVar(ele, i))>CutVars_[i];
-    return TMath::Abs(ReturnCandVar(ele, i)) < CutVars_[i];
-  }
-  if (InvVars_[i+nBarrelVars_]) {
-    if (InvVars_[i])
-      return TMath::Abs(ReturnCandVar(ele, i))>CutVars_[i+nBarrelVars_];    
-  }
-  return TMath::Abs(ReturnCandVar(ele, i)) < CutVars_[i+nBarrelVars_];
+  return selector_->passesInverted(*ele, i);
 }
 ////////////////////////////////////////////////////////////////////////
 Double_t WenuPlots::ReturnCandVar(const pat::Electron *ele, int i) {
-  if (i==0) return ele->dr03TkSumPt()/ele->p4().Pt();
-  else if (i==1) return ele->dr03EcalRecHitSumEt()/ele->p4().Pt();
-  else if (i==2) return ele->dr03HcalTowerSumEt()/ele->p4().Pt();
-  else if (i==3) return ele->scSigmaIEtaIEta();
-  else if (i==4) return ele->deltaPhiSuperClusterTrackAtVtx();
-  else if (i==5) return ele->deltaEtaSuperClusterTrackAtVtx();
-  else if (i==6) return ele->hadronicOverEm();
-  else if (i==7) {
-    if (ele->isEB()){
-      return ( ele->dr03TkSumPt()+std::max(float(0.),ele->dr03EcalRecHitSumEt()-1)
-	       + ele->dr03HcalTowerSumEt())/ele->p4().Pt(); }
-    else { // pedestal subtraction is only in barrel
-      return ( ele->dr03TkSumPt()+ele->dr03EcalRecHitSumEt()
-	       + ele->dr03HcalTowerSumEt())/ele->p4().Pt(); }
+  return selector_->value(*ele, i);
+}
+/////////////////////////////////////////////////////////////////////////
+// the ElectronFeatures of ele, read or computed once per electron and event
+const float * WenuPlots::Features(const pat::Electron *ele) {
+  return selector_->accessor().features(*ele);
+}
+/////////////////////////////////////////////////////////////////////////
+// for the systematic variations: passFixed true if the cuts that do not
+// depend on the electron energy pass, and the range of scales of the
+// electron energy for which the others pass: the relative isolations
+// (iso/pT falls with the scale) and E/p (rises with it). The cuts are
+// systematicsCuts_, those of CheckCuts
+void WenuPlots::EtScaleRange(const pat::Electron *ele, Bool_t& passFixed,
+			     Double_t& minScale, Double_t& maxScale) {
+  typedef WenuSelectorVars V;
+  passFixed = true;
+  minScale = 0.;
+  maxScale = std::numeric_limits<Double_t>::max();
+  const Bool_t barrel = selector_->accessor().isBarrel(*ele);
+  for (int i=0; i<V::NVARS; ++i) {
+    const Double_t cutEB = systematicsCuts_[i], cutEE = systematicsCuts_[i+V::NVARS];
+    // the cuts that the fixed selection removes
+    if (fixedSelection_ && cutEB >= WenuFixedSelectorDisabled
+	&& cutEE >= WenuFixedSelectorDisabled) continue;
+    const Double_t val = TMath::Abs(selector_->value(*ele, i));
+    const Double_t cut = barrel ? cutEB : cutEE;
+    const Bool_t relative = (i==V::TRACK_ISO || i==V::ECAL_ISO || i==V::HCAL_ISO || i==V::C_ISO);
+    if (relative && cut > 0.) minScale = TMath::Max(minScale, val/cut);
+    else if (i==V::EOP && val > 0.) maxScale = TMath::Min(maxScale, cut/val);
+    else if (not (val < cut)) passFixed = false;
+  }
+}
+/////////////////////////////////////////////////////////////////////////
+// the h_met, h_mt of the systematic variations for one event;
+// passSelection is used only with the precalculated ID
+void WenuPlots::FillSystematics(const pat::Electron *ele, Double_t scEt, Double_t scEta,
+				Double_t scPhi, Double_t met, Double_t metPhi,
+				Bool_t passSelection)
+{
+  systematics_->compute(scEt, scPhi, TMath::Abs(scEta)<1.479, met, metPhi);
+  if (usePrecalcID_)
+    systematics_->select(passSelection, 0., std::numeric_limits<Double_t>::max());
+  else {
+    Bool_t passFixed;
+    Double_t minScale, maxScale;
+    EtScaleRange(ele, passFixed, minScale, maxScale);
+    systematics_->select(passFixed, minScale, maxScale);
+  }
+  for (int v=0; v<systematics_->size(); ++v) {
+    if (not systematics_->passes(v)) continue;
+    h_met_syst[v]->Fill(systematics_->met(v));
+    h_mt_syst[v]->Fill(systematics_->mt(v));
+    if (TMath::Abs(scEta)<1.479) {
+      h_met_EB_syst[v]->Fill(systematics_->met(v));
+      h_mt_EB_syst[v]->Fill(systematics_->mt(v));
+    }
+    if (TMath::Abs(scEta)>1.479) {
+      h_met_EE_syst[v]->Fill(systematics_->met(v));
+      h_mt_EE_syst[v]->Fill(systematics_->mt(v));
+    }
   }
-  //  else if (i==8) return ele->gsfTrack()->dxy(bspotPosition_);
-  else if (i==8) return fabs(ele->dB());
-  else if (i==9) return ele->eSuperClusterOverP();
-  else if (i==10) return ele->userIsolation(pat::TrackIso);
-  else if (i==11) return ele->userIsolation(pat::EcalIso);
-  else if (i==12) return ele->userIsolation(pat::HcalIso);  
-  std::cout << "Error in WenuPlots::ReturnCandVar" << std::endl;
-  return -1.;
+}
 
+/////////////////////////////////////////////////////////////////////////
+// the histograms and the cut flow counters to
+// snapshotServer_; the copy is made here, in the event loop, the server
+// thread only reads the published copies
+void WenuPlots::PublishSnapshot()
+{
+  std::shared_ptr<HistogramSnapshot> snapshot(new HistogramSnapshot);
+  snapshot->events = snapshotEvents_;
+  snapshot->time = std::time(0);
+  snapshot->counters = cutFlow_->counters();
+  for (unsigned int i=0; i<snapshotHistos_.size(); ++i) snapshot->add(snapshotHistos_[i]);
+  snapshotServer_->publish(snapshot);
+}
+/////////////////////////////////////////////////////////////////////////
+// one line of key=value for the event: the selection variables, the
+// preselection userInts and all the electron IDs of the electron
+void WenuPlots::DebugDump(const edm::Event& iEvent, const pat::Electron *ele)
+{
+  static const char *ids[] = {"simpleEleId95relIso", "simpleEleId90relIso",
+			      "simpleEleId85relIso", "simpleEleId80relIso",
+			      "simpleEleId70relIso", "simpleEleId60relIso",
+			      "simpleEleId95cIso", "simpleEleId90cIso",
+			      "simpleEleId85cIso", "simpleEleId80cIso",
+			      "simpleEleId70cIso", "simpleEleId60cIso"};
+  std::ostringstream line;
+  line << "run=" << iEvent.run() << " lumi=" << iEvent.luminosityBlock()
+       << " event=" << iEvent.id().event()
+       << " scEt=" << transverseEnergy(ele->superCluster()->energy(), ele->superCluster()->eta())
+       << " scEta=" << ele->superCluster()->eta() << " scPhi=" << ele->superCluster()->phi();
+  line << " trackIso=" << ele->userIsolation(pat::TrackIso) << " " << ele->trackIso()
+       << " ecalIso=" << ele->userIsolation(pat::EcalIso) << " " << ele->ecalIso()
+       << " hcalIso=" << ele->userIsolation(pat::HcalIso) << " " << ele->hcalIso()
+       << " sihih=" << ele->scSigmaIEtaIEta()
+       << " dphi=" << ele->deltaPhiSuperClusterTrackAtVtx()
+       << " deta=" << ele->deltaEtaSuperClusterTrackAtVtx()
+       << " hoe=" << ele->hadronicOverEm()
+       << " mishits=" << ele->gsfTrack()->trackerExpectedHitsInner().numberOfHits();
+  const char *userInts[] = {"PassConversionRejection", "PassValidFirstPXBHit",
+			    "NumberOfExpectedMissingHits", "failsSecondElectronCut"};
+  for (int i=0; i<4; ++i)
+    if (ele->hasUserInt(userInts[i]))
+      line << " " << userInts[i] << "=" << ele->userInt(userInts[i]);
+  for (int i=0; i<12; ++i)
+    if (ele->isElectronIDAvailable(ids[i]))
+      line << " " << ids[i] << "=" << ele->electronID(ids[i]);
+  line << " preselection=" << PassPreselectionCriteria(ele)
+       << " selection=" << CheckCuts(ele);
+  debugDump_->write(line.str());
 }
 /////////////////////////////////////////////////////////////////////////
 Bool_t WenuPlots::PassPreselectionCriteria(const pat::Electron *ele) {
@@ -821,36 +1052,36 @@ Bool_t WenuPlots::PassPreselectionCriteria(const pat::Electron *ele) {
   Bool_t passPXB = true;
   Bool_t passEMH = true;
   if (useConversionRejection_) {
-    if (ele->hasUserInt("PassConversionRejection")) {
-      //std::cout << "con rej: " << ele->userInt("PassConversionRejection") << std::endl;
-      if (not (ele->userInt("PassConversionRejection")==1)) passConvRej = false;
+    if (passConversionRejection_.available(*ele)) {
+      if (not (passConversionRejection_.value(*ele)==1)) passConvRej = false;
     }
     else {
-      std::cout << "WenuPlots: WARNING: Conversion Rejection Request Disregarded: "
-		<< "you must calculate it before " << std::endl;
+      WENU_DIAG(*diag_, WENU_DIAG_WARNING, msgNoConvRej_,
+		"WARNING: Conversion Rejection Request Disregarded: "
+		<< "you must calculate it before ");
       // return true;
     }
   }
   if (useValidFirstPXBHit_) {
-    if (ele->hasUserInt("PassValidFirstPXBHit")) {
-      //std::cout << "valid1stPXB: " << ele->userInt("PassValidFirstPXBHit") << std::endl;
-      if (not (ele->userInt("PassValidFirstPXBHit")==1)) passPXB = false;
+    if (passValidFirstPXBHit_.available(*ele)) {
+      if (not (passValidFirstPXBHit_.value(*ele)==1)) passPXB = false;
     }
     else {
-      std::cout << "WenuPlots: WARNING: Valid First PXB Hit Request Disregarded: "
-                << "you must calculate it before " << std::endl;
+      WENU_DIAG(*diag_, WENU_DIAG_WARNING, msgNoPXB_,
+		"WARNING: Valid First PXB Hit Request Disregarded: "
+		<< "you must calculate it before ");
       // return true;
     }
   }
   if (useExpectedMissingHits_) {
-    if (ele->hasUserInt("NumberOfExpectedMissingHits")) {
-      //std::cout << "missing hits: " << ele->userInt("NumberOfExpectedMissingHits") << std::endl;
-      if (ele->userInt("NumberOfExpectedMissingHits")>maxNumberOfExpectedMissingHits_) 
+    if (numberOfExpectedMissingHits_.available(*ele)) {
+      if (numberOfExpectedMissingHits_.value(*ele)>maxNumberOfExpectedMissingHits_) 
 	passEMH = false;
     }
     else {
-      std::cout << "WenuPlots: WARNING: Number of Expected Missing Hits Request Disregarded: "
-                << "you must calculate it before " << std::endl;
+      WENU_DIAG(*diag_, WENU_DIAG_WARNING, msgNoMissingHits_,
+		"WARNING: Number of Expected Missing Hits Request Disregarded: "
+		<< "you must calculate it before ");
       // return true;
     }
   }
@@ -916,6 +1147,17 @@ WenuPlots::beginJob()
     new TH1F("h_trackIso_eb_NmOne","trackIso EB N-1 plot",80,0,8);
   h_trackIso_ee_NmOne = 
     new TH1F("h_trackIso_ee_NmOne","trackIso EE N-1 plot",80,0,8);
+  //
+  // the same h_met, h_mt for each systematic variation
+  for (int v=0; v<systematics_->size(); ++v) {
+    const TString name = systematics_->name(v);
+    h_met_syst.push_back(new TH1F("h_met_"+name, "h_met_"+name, 200, 0, 200));
+    h_mt_syst.push_back(new TH1F("h_mt_"+name, "h_mt_"+name, 200, 0, 200));
+    h_met_EB_syst.push_back(new TH1F("h_met_EB_"+name, "h_met_EB_"+name, 200, 0, 200));
+    h_mt_EB_syst.push_back(new TH1F("h_mt_EB_"+name, "h_mt_EB_"+name, 200, 0, 200));
+    h_met_EE_syst.push_back(new TH1F("h_met_EE_"+name, "h_met_EE_"+name, 200, 0, 200));
+    h_mt_EE_syst.push_back(new TH1F("h_mt_EE_"+name, "h_mt_EE_"+name, 200, 0, 200));
+  }
 
   
   // if you add some new variable change the nBarrelVars_ accordingly
@@ -981,6 +1223,45 @@ WenuPlots::beginJob()
   InvVars_.push_back( trackIsoUser_EE_inv );//10
   InvVars_.push_back( ecalIsoUser_EE_inv  );//11
   InvVars_.push_back( hcalIsoUser_EE_inv  );//12
+  selector_.reset(new WenuSelector<PatElectronAccessor>(CutVars_, InvVars_));
+  // fixedSelection replaces the cuts of the configuration in CheckCuts:
+  // they must be the same, or editing them would not change h_met. A cut
+  // that the working point removes may have any value at or above
+  // WenuFixedSelectorDisabled
+  if (fixedSelection_) {
+    const std::vector<double> fixedCuts = spring10Cuts(fixedSelectionName_);
+    for (unsigned int i=0; i<CutVars_.size(); ++i) {
+      if (fixedCuts[i] >= WenuFixedSelectorDisabled && CutVars_[i] >= WenuFixedSelectorDisabled)
+	continue;
+      if (TMath::Abs(CutVars_[i] - fixedCuts[i]) > 1.e-9*TMath::Abs(fixedCuts[i]))
+	throw cms::Exception("Configuration")
+	  << "WenuPlots: cut " << i << " is " << CutVars_[i] << " in the configuration and "
+	  << fixedCuts[i] << " in the working point " << fixedSelectionName_
+	  << " of fixedSelection; change both or set fixedSelection to \"\"\n";
+    }
+  }
+  // the cuts of the systematic variations: those of CheckCuts
+  systematicsCuts_ = fixedSelection_ ? spring10Cuts(fixedSelectionName_) : CutVars_;
+  //
+  // the snapshots: all the histograms, the systematic variations too
+  if (snapshotPort_ > 0) {
+    TH1F *histos[] =
+      {h_met, h_mt, h_met_EB, h_mt_EB, h_met_EE, h_mt_EE,
+       h_met_inverse, h_mt_inverse, h_met_inverse_EB, h_mt_inverse_EB,
+       h_met_inverse_EE, h_mt_inverse_EE,
+       h_scEt, h_scEta, h_scPhi,
+       h_EB_trkiso, h_EB_ecaliso, h_EB_hcaliso, h_EB_sIetaIeta, h_EB_dphi, h_EB_deta, h_EB_HoE,
+       h_EE_trkiso, h_EE_ecaliso, h_EE_hcaliso, h_EE_sIetaIeta, h_EE_dphi, h_EE_deta, h_EE_HoE,
+       h_trackIso_eb_NmOne, h_trackIso_ee_NmOne};
+    snapshotHistos_.assign(histos, histos + sizeof(histos)/sizeof(histos[0]));
+    for (int v=0; v<systematics_->size(); ++v) {
+      TH1F *syst[] = {h_met_syst[v], h_mt_syst[v], h_met_EB_syst[v], h_mt_EB_syst[v],
+		      h_met_EE_syst[v], h_mt_EE_syst[v]};
+      snapshotHistos_.insert(snapshotHistos_.end(), syst, syst + 6);
+    }
+    snapshotServer_.reset(new HistogramSnapshotServer("WenuPlots", snapshotPort_));
+    if (not snapshotServer_->running()) snapshotServer_.reset();
+  }
   //
   //
   // ________________________________________________________________________
@@ -1057,6 +1338,8 @@ WenuPlots::beginJob()
     vbtfSele_tree->Branch("event_tcSumEt",&event_tcSumEt,"event_tcSumEt/F");
   }
   vbtfSele_tree->Branch("event_datasetTag",&event_datasetTag,"event_dataSetTag/I");  
+  vbtfSele_tree->Branch("ele_passes_preselection",&ele_passes_preselection,"ele_passes_preselection/I");
+  vbtfSele_tree->Branch("ele_passes_cuts",&ele_passes_cuts,"ele_passes_cuts/I");
   // 
   //
   // everything after preselection
@@ -1166,6 +1449,8 @@ WenuPlots::beginJob()
     vbtfPresele_tree->Branch("ele2nd_hltmatched_dr",&ele2nd_hltmatched_dr,"ele2nd_hltmatched_dr/F");
   }
   vbtfPresele_tree->Branch("event_datasetTag",&event_datasetTag,"event_dataSetTag/I");  
+  vbtfPresele_tree->Branch("ele_passes_preselection",&ele_passes_preselection,"ele_passes_preselection/I");
+  vbtfPresele_tree->Branch("ele_passes_cuts",&ele_passes_cuts,"ele_passes_cuts/I");
 
   //
   // _________________________________________________________________________
@@ -1179,6 +1464,16 @@ WenuPlots::beginJob()
 // ------------ method called once each job just after ending the event loop  -
 void 
 WenuPlots::endJob() {
+  // the final one, served until the module is deleted
+  if (snapshotServer_) PublishSnapshot();
+  diag_->summary();
+  if (fixedSelection_ && crossCheckFixedSelection_)
+    std::cout << "WenuPlots: fixed selection " << fixedSelectionName_ << " cross-check: "
+	      << crossCheckDifferences_ << " of " << crossCheckElectrons_
+	      << " electrons differ from the runtime cuts" << std::endl;
+  cutFlow_->print("WenuPlots");
+  if (not cutFlow_->write(cutFlowFile_))
+    std::cout << "WenuPlots: could not write " << cutFlowFile_ << std::endl;
   TFile * newfile = new TFile(TString(outputFile_),"RECREATE");
   //
   // for consistency all the plots are in the root file
@@ -1223,6 +1518,15 @@ WenuPlots::endJob() {
   h_trackIso_eb_NmOne->Write();
   h_trackIso_ee_NmOne->Write();
   //
+  for (int v=0; v<systematics_->size(); ++v) {
+    h_met_syst[v]->Write();
+    h_mt_syst[v]->Write();
+    h_met_EB_syst[v]->Write();
+    h_mt_EB_syst[v]->Write();
+    h_met_EE_syst[v]->Write();
+    h_mt_EE_syst[v]->Write();
+  }
+  //
   newfile->Close();
   //
   // write the VBTF trees
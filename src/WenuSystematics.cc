@@ -0,0 +1,73 @@
+#include "ElectroWeakAnalysis/WENu/interface/WenuSystematics.h"
+#include "ElectroWeakAnalysis/WENu/interface/WenuKinematics.h"
+
+#include <cmath>
+
+#include "FWCore/Utilities/interface/Exception.h"
+
+
+WenuSystematics::WenuSystematics(const std::vector<edm::ParameterSet>& variations)
+{
+  for (unsigned int v=0; v<variations.size(); ++v) {
+    const edm::ParameterSet& ps = variations[v];
+    const std::string name = ps.getUntrackedParameter<std::string>("name");
+    for (unsigned int w=0; w<names_.size(); ++w)
+      if (names_[w] == name)
+	throw cms::Exception("Configuration")
+	  << "WenuSystematics: variation " << name << " given twice\n";
+    names_.push_back(name);
+    ebScale_.push_back(ps.getUntrackedParameter<double>("ebScale", 1.));
+    eeScale_.push_back(ps.getUntrackedParameter<double>("eeScale", 1.));
+    metScale_.push_back(ps.getUntrackedParameter<double>("metScale", 1.));
+    metSmearing_.push_back(ps.getUntrackedParameter<double>("metSmearing", 0.));
+    random_.push_back(new TRandom3(ps.getUntrackedParameter<unsigned int>("seed", 12345)));
+  }
+  const int n = names_.size();
+  scale_.resize(n);
+  et_.resize(n);   ex_.resize(n);   ey_.resize(n);
+  met_.resize(n);  mx_.resize(n);   my_.resize(n);
+  mt_.resize(n);
+  pass_.resize(n);
+}
+
+WenuSystematics::~WenuSystematics()
+{
+  for (unsigned int v=0; v<random_.size(); ++v) delete random_[v];
+}
+
+void
+WenuSystematics::compute(double et, double phi, bool isEB, double met, double metPhi)
+{
+  const int n = size();
+  if (n == 0) return;
+  const double cosPhi = std::cos(phi), sinPhi = std::sin(phi);
+  const double metX = met*std::cos(metPhi), metY = met*std::sin(metPhi);
+  // the hadronic recoil
+  const double ux = -(metX + et*cosPhi), uy = -(metY + et*sinPhi);
+  const std::vector<double>& scale = isEB ? ebScale_ : eeScale_;
+  for (int v=0; v<n; ++v) {
+    scale_[v] = scale[v];
+    et_[v] = scale[v]*et;
+    ex_[v] = et_[v]*cosPhi;
+    ey_[v] = et_[v]*sinPhi;
+    mx_[v] = -ex_[v] - metScale_[v]*ux;
+    my_[v] = -ey_[v] - metScale_[v]*uy;
+  }
+  // the random numbers only for the variations that smear
+  for (int v=0; v<n; ++v) {
+    if (metSmearing_[v] > 0.) {
+      mx_[v] += random_[v]->Gaus(0., metSmearing_[v]);
+      my_[v] += random_[v]->Gaus(0., metSmearing_[v]);
+    }
+  }
+  for (int v=0; v<n; ++v) met_[v] = std::sqrt(mx_[v]*mx_[v] + my_[v]*my_[v]);
+  transverseMassPairs(n, &et_[0], &ex_[0], &ey_[0], &met_[0], &mx_[0], &my_[0], &mt_[0]);
+}
+
+void
+WenuSystematics::select(bool passFixed, double minScale, double maxScale)
+{
+  const int n = size();
+  for (int v=0; v<n; ++v)
+    pass_[v] = passFixed && scale_[v] > minScale && scale_[v] < maxScale;
+}
@@ -131,6 +131,7 @@ process.rootskimmer = cms.EDAnalyzer(
     genMetCollectionTag= cms.untracked.InputTag("genMetCalo", "", "HLT8E29"),
     t1MetCollectionTag = cms.untracked.InputTag("layer1METs"),
     t1MetCollectionTagTwiki = cms.untracked.InputTag("layer1TwikiT1METs"),
+    mcMetCollectionTag = cms.untracked.InputTag("layer1mcMETs"),
     
 # HLT ...............................................................    
     HLTCollectionE29 = cms.untracked.InputTag('hltTriggerSummaryAOD','','HLT8E29'),
@@ -144,6 +145,10 @@ process.rootskimmer = cms.EDAnalyzer(
     EndcapMinEta = cms.untracked.double(1.56),
     EndcapMaxEta = cms.untracked.double(2.5),
 
+# some extra collections
+    ctfTracksTag = cms.untracked.InputTag("generalTracks"),
+    corHybridsc = cms.untracked.InputTag("correctedHybridSuperClusters"),
+    multi5x5sc = cms.untracked.InputTag("multi5x5SuperClustersWithPreshower"),
 # some MC information
     MCCollection = cms.untracked.InputTag("genParticles", "", "HLT8E29"),
     # deta and dphi have default values and there is no reason to change them
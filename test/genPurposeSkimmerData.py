@@ -50,7 +50,10 @@ process.load("PhysicsTools.PatAlgos.patSequences_cff")
 
 
 process.options = cms.untracked.PSet(
-    Rethrow = cms.untracked.vstring('ProductNotFound')
+    Rethrow = cms.untracked.vstring('ProductNotFound'),
+    # the skimmer writes one tree per stream (see mergeStreamOutputs)
+    numberOfThreads = cms.untracked.uint32(4),
+    numberOfStreams = cms.untracked.uint32(0),
 )
 
 ## this is for the correct calculation of type1 MET
@@ -144,6 +147,9 @@ process.rootskimmer = cms.EDAnalyzer(
     'GenPurposeSkimmerData',
 # output file                   #######################################
     outputfile = cms.untracked.string('./bkg.root'),
+    # True: the stream trees are merged in bkg.root in (run, lumi, event) order
+    # False: bkg_stream<N>.root are kept and bkg.root has their event index
+    mergeStreamOutputs = cms.untracked.bool(True),
     InputTagEnding = cms.untracked.string(inputTagEnding),
 # collections
     ElectronCollection = cms.untracked.InputTag("selectedLayer1Electrons"),
@@ -171,6 +177,9 @@ process.rootskimmer = cms.EDAnalyzer(
     ctfTracksTag = cms.untracked.InputTag("generalTracks", "", "RECO"),
     corHybridsc = cms.untracked.InputTag("correctedHybridSuperClusters","", "RECO"),
     multi5x5sc = cms.untracked.InputTag("multi5x5SuperClustersWithPreshower","", "RECO"),
+# early out: skip events without a probe candidate above ProbeSCMinEt
+    skipEventsWithoutProbe = cms.untracked.bool(False),
+    ProbeSCMinEt = cms.untracked.double(20.),
     )
 
 #process.patDefaultSequence.remove(process.allLayer1Taus)
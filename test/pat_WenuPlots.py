@@ -76,25 +76,27 @@ process.patElectrons.userIsolation = cms.PSet(
     )
 process.patElectrons.addElectronID = cms.bool(True)
 process.patElectrons.electronIDSources = cms.PSet(
-    simpleEleId95relIso= cms.InputTag("simpleEleId95relIso"),
-    simpleEleId90relIso= cms.InputTag("simpleEleId90relIso"),
-    simpleEleId85relIso= cms.InputTag("simpleEleId85relIso"),
-    simpleEleId80relIso= cms.InputTag("simpleEleId80relIso"),
-    simpleEleId70relIso= cms.InputTag("simpleEleId70relIso"),
-    simpleEleId60relIso= cms.InputTag("simpleEleId60relIso"),
-    simpleEleId95cIso= cms.InputTag("simpleEleId95cIso"),
-    simpleEleId90cIso= cms.InputTag("simpleEleId90cIso"),
-    simpleEleId85cIso= cms.InputTag("simpleEleId85cIso"),
-    simpleEleId80cIso= cms.InputTag("simpleEleId80cIso"),
-    simpleEleId70cIso= cms.InputTag("simpleEleId70cIso"),
-    simpleEleId60cIso= cms.InputTag("simpleEleId60cIso"),    
+    simpleEleId95relIso= cms.InputTag("simpleEleIds", "simpleEleId95relIso"),
+    simpleEleId90relIso= cms.InputTag("simpleEleIds", "simpleEleId90relIso"),
+    simpleEleId85relIso= cms.InputTag("simpleEleIds", "simpleEleId85relIso"),
+    simpleEleId80relIso= cms.InputTag("simpleEleIds", "simpleEleId80relIso"),
+    simpleEleId70relIso= cms.InputTag("simpleEleIds", "simpleEleId70relIso"),
+    simpleEleId60relIso= cms.InputTag("simpleEleIds", "simpleEleId60relIso"),
+    simpleEleId95cIso= cms.InputTag("simpleEleIds", "simpleEleId95cIso"),
+    simpleEleId90cIso= cms.InputTag("simpleEleIds", "simpleEleId90cIso"),
+    simpleEleId85cIso= cms.InputTag("simpleEleIds", "simpleEleId85cIso"),
+    simpleEleId80cIso= cms.InputTag("simpleEleIds", "simpleEleId80cIso"),
+    simpleEleId70cIso= cms.InputTag("simpleEleIds", "simpleEleId70cIso"),
+    simpleEleId60cIso= cms.InputTag("simpleEleIds", "simpleEleId60cIso"),    
     )
 ##
 process.patElectrons.addGenMatch = cms.bool(False)
 process.patElectrons.embedGenMatch = cms.bool(False)
 ##
 process.load("ElectroWeakAnalysis.WENu.simpleEleIdSequence_cff")
-process.patElectronIDs = cms.Sequence(process.simpleEleIdSequence)
+## the electron variables of the plotter, computed once per event
+process.load("ElectroWeakAnalysis.WENu.electronFeatures_cfi")
+process.patElectronIDs = cms.Sequence(process.simpleEleIdSequence+process.electronFeatures)
 process.makePatElectrons = cms.Sequence(process.patElectronIDs*process.patElectrons)
 # process.makePatMuons may be needed depending on how you calculate the MET
 process.makePatCandidates = cms.Sequence(process.makePatElectrons+process.makePatMETs)
@@ -168,7 +170,39 @@ process.plotter = cms.EDAnalyzer('WenuPlots',
                                  usePrecalcIDValue = cms.untracked.double(7),
                                  #
                                  wenuCollectionTag = cms.untracked.InputTag(
-                                                   "wenuFilter","selectedWenuCandidates","PAT")
+                                                   "wenuFilter","selectedWenuCandidates","PAT"),
+                                 # the electron variables (ElectronFeatureProducer)
+                                 electronFeatures = cms.untracked.InputTag("electronFeatures"),
+                                 # systematic variations in the same job: h_met_<name>,
+                                 # h_mt_<name> (and _EB, _EE) for each
+                                 systematicVariations = cms.untracked.VPSet(
+                                     cms.PSet(name = cms.untracked.string("escaleEBup"),
+                                              ebScale = cms.untracked.double(1.02)),
+                                     cms.PSet(name = cms.untracked.string("escaleEEup"),
+                                              eeScale = cms.untracked.double(1.05)),
+                                     cms.PSet(name = cms.untracked.string("metScaleUp"),
+                                              metScale = cms.untracked.double(1.1)),
+                                     cms.PSet(name = cms.untracked.string("metSmear"),
+                                              metSmearing = cms.untracked.double(2.),
+                                              seed = cms.untracked.uint32(4357)),
+                                     ),
+                                 # the same cuts as selection_80relIso, compiled in
+                                 # (Spring10WorkingPoints.h); the job stops if they differ
+                                 # from the cuts above, "" to use the cuts above
+                                 # after editing them. The cross-check compares the
+                                 # decisions of the two
+                                 fixedSelection = cms.untracked.string("80relIso"),
+                                 crossCheckFixedSelection = cms.untracked.bool(False),
+                                 # e.g. 8080: curl http://localhost:8080/ for the histograms of the
+                                 # running job, a new copy every snapshotEvery events
+                                 snapshotPort = cms.untracked.int32(0),
+                                 snapshotEvery = cms.untracked.int32(10000),
+                                 # event loop warnings: each at most 10 times
+                                 diagnosticsLimit = cms.untracked.uint32(10),
+                                 # everything about these events in debugDumpFile
+                                 debugEvents = cms.untracked.VEventID(),
+                                 #debugEvents = cms.untracked.VEventID('1:1234', '1:5678'),
+                                 debugDumpFile = cms.untracked.string("WenuPlots_debug.txt"),
                                  )
 
 
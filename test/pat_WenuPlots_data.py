@@ -75,25 +75,27 @@ process.patElectrons.userIsolation = cms.PSet(
     )
 process.patElectrons.addElectronID = cms.bool(True)
 process.patElectrons.electronIDSources = cms.PSet(
-    simpleEleId95relIso= cms.InputTag("simpleEleId95relIso"),
-    simpleEleId90relIso= cms.InputTag("simpleEleId90relIso"),
-    simpleEleId85relIso= cms.InputTag("simpleEleId85relIso"),
-    simpleEleId80relIso= cms.InputTag("simpleEleId80relIso"),
-    simpleEleId70relIso= cms.InputTag("simpleEleId70relIso"),
-    simpleEleId60relIso= cms.InputTag("simpleEleId60relIso"),
-    simpleEleId95cIso= cms.InputTag("simpleEleId95cIso"),
-    simpleEleId90cIso= cms.InputTag("simpleEleId90cIso"),
-    simpleEleId85cIso= cms.InputTag("simpleEleId85cIso"),
-    simpleEleId80cIso= cms.InputTag("simpleEleId80cIso"),
-    simpleEleId70cIso= cms.InputTag("simpleEleId70cIso"),
-    simpleEleId60cIso= cms.InputTag("simpleEleId60cIso"),    
+    simpleEleId95relIso= cms.InputTag("simpleEleIds", "simpleEleId95relIso"),
+    simpleEleId90relIso= cms.InputTag("simpleEleIds", "simpleEleId90relIso"),
+    simpleEleId85relIso= cms.InputTag("simpleEleIds", "simpleEleId85relIso"),
+    simpleEleId80relIso= cms.InputTag("simpleEleIds", "simpleEleId80relIso"),
+    simpleEleId70relIso= cms.InputTag("simpleEleIds", "simpleEleId70relIso"),
+    simpleEleId60relIso= cms.InputTag("simpleEleIds", "simpleEleId60relIso"),
+    simpleEleId95cIso= cms.InputTag("simpleEleIds", "simpleEleId95cIso"),
+    simpleEleId90cIso= cms.InputTag("simpleEleIds", "simpleEleId90cIso"),
+    simpleEleId85cIso= cms.InputTag("simpleEleIds", "simpleEleId85cIso"),
+    simpleEleId80cIso= cms.InputTag("simpleEleIds", "simpleEleId80cIso"),
+    simpleEleId70cIso= cms.InputTag("simpleEleIds", "simpleEleId70cIso"),
+    simpleEleId60cIso= cms.InputTag("simpleEleIds", "simpleEleId60cIso"),    
     )
 ##
 process.patElectrons.addGenMatch = cms.bool(False)
 process.patElectrons.embedGenMatch = cms.bool(False)
 ##
 process.load("ElectroWeakAnalysis.WENu.simpleEleIdSequence_cff")
-process.patElectronIDs = cms.Sequence(process.simpleEleIdSequence)
+## the electron variables of the plotter, computed once per event
+process.load("ElectroWeakAnalysis.WENu.electronFeatures_cfi")
+process.patElectronIDs = cms.Sequence(process.simpleEleIdSequence+process.electronFeatures)
 process.makePatElectrons = cms.Sequence(process.patElectronIDs*process.patElectrons)
 # process.makePatMuons may be needed depending on how you calculate the MET
 process.makePatCandidates = cms.Sequence(process.makePatElectrons+process.makePatMETs)
@@ -195,7 +197,9 @@ process.plotter = cms.EDAnalyzer('WenuPlots',
                                  usePrecalcIDValue = cms.untracked.double(7),
                                  #
                                  wenuCollectionTag = cms.untracked.InputTag(
-                                                   "wenuFilter","selectedWenuCandidates","PAT")
+                                                   "wenuFilter","selectedWenuCandidates","PAT"),
+                                 # the electron variables (ElectronFeatureProducer)
+                                 electronFeatures = cms.untracked.InputTag("electronFeatures"),
                                  )
 
 
@@ -105,18 +105,18 @@ process.patElectrons.isoDeposits = cms.PSet()
 process.patElectrons.userIsolation = cms.PSet( )
 process.patElectrons.addElectronID = cms.bool(True)
 process.patElectrons.electronIDSources = cms.PSet(
-    simpleEleId95relIso= cms.InputTag("simpleEleId95relIso"),
-    simpleEleId90relIso= cms.InputTag("simpleEleId90relIso"),
-    simpleEleId85relIso= cms.InputTag("simpleEleId85relIso"),
-    simpleEleId80relIso= cms.InputTag("simpleEleId80relIso"),
-    simpleEleId70relIso= cms.InputTag("simpleEleId70relIso"),
-    simpleEleId60relIso= cms.InputTag("simpleEleId60relIso"),
-    simpleEleId95cIso= cms.InputTag("simpleEleId95cIso"),
-    simpleEleId90cIso= cms.InputTag("simpleEleId90cIso"),
-    simpleEleId85cIso= cms.InputTag("simpleEleId85cIso"),
-    simpleEleId80cIso= cms.InputTag("simpleEleId80cIso"),
-    simpleEleId70cIso= cms.InputTag("simpleEleId70cIso"),
-    simpleEleId60cIso= cms.InputTag("simpleEleId60cIso"),    
+    simpleEleId95relIso= cms.InputTag("simpleEleIds", "simpleEleId95relIso"),
+    simpleEleId90relIso= cms.InputTag("simpleEleIds", "simpleEleId90relIso"),
+    simpleEleId85relIso= cms.InputTag("simpleEleIds", "simpleEleId85relIso"),
+    simpleEleId80relIso= cms.InputTag("simpleEleIds", "simpleEleId80relIso"),
+    simpleEleId70relIso= cms.InputTag("simpleEleIds", "simpleEleId70relIso"),
+    simpleEleId60relIso= cms.InputTag("simpleEleIds", "simpleEleId60relIso"),
+    simpleEleId95cIso= cms.InputTag("simpleEleIds", "simpleEleId95cIso"),
+    simpleEleId90cIso= cms.InputTag("simpleEleIds", "simpleEleId90cIso"),
+    simpleEleId85cIso= cms.InputTag("simpleEleIds", "simpleEleId85cIso"),
+    simpleEleId80cIso= cms.InputTag("simpleEleIds", "simpleEleId80cIso"),
+    simpleEleId70cIso= cms.InputTag("simpleEleIds", "simpleEleId70cIso"),
+    simpleEleId60cIso= cms.InputTag("simpleEleIds", "simpleEleId60cIso"),    
     )
 ##
 process.patElectrons.addGenMatch = cms.bool(False)
@@ -248,7 +248,12 @@ process.plotter = cms.EDAnalyzer('WenuPlots',
 # if you run on data then you have to do misalignment  corrections first!!!
 # not to be used with MC!!
 #process.load("RecoEgamma.EgammaTools.correctedElectronsProducer_cfi")
+#
+# the acceptance and its CTEQ66 uncertainty, all 45 members in this pass
+# (before the filter: it needs all the events)
+process.load("ElectroWeakAnalysis.WENu.pdfAcceptance_cfi")
+#
 #process.p = cms.Path( process.gsfElectrons + process.patDefaultSequence +process.wenuFilter + process.plotter)
-process.p = cms.Path( process.ourJetSequence * process.patDefaultSequence +process.wenuFilter + process.plotter)
+process.p = cms.Path( process.pdfAcceptance + process.ourJetSequence * process.patDefaultSequence +process.wenuFilter + process.plotter)
 
 